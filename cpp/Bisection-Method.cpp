@@ -1,6 +1,8 @@
 #include <iostream>
 #include <cmath>
 #include <iomanip>
+#include "expression-jit.h"
+#include "root-finding.h"
 
 using namespace std;
 
@@ -8,54 +10,48 @@ double f(double x) {
     return x * x * x - x - 2; 
 }
 
-void bisectionMethod(double a, double b, double tol, int maxIter) {
+void printHeader(double a, double b, double tol, int maxIter) {
     cout << "\nBisection Method for root finding:\n";
     cout << "Initial interval: [" << a << ", " << b << "]\n";
-    cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n\n";
-    cout << setw(5) << "Iter" << setw(12) << "a" << setw(12) << "b" 
-         << setw(12) << "c" << setw(12) << "f(c)" << endl;
-    cout << string(60, '-') << endl;
+    cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n";
+}
 
-    if (f(a) * f(b) >= 0) {
-        cout << "Error: f(a) and f(b) must have opposite signs.\n";
-        return;
+void printIterations(const IterationTrace& trace) {
+    cout << "\n" << setw(5) << "Iter" << setw(12) << "a" << setw(12) << "b" << setw(12) << "c" << setw(12) << "f(c)" << endl;
+    cout << string(60, '-') << endl;
+    if (trace.total() > (unsigned long long)trace.size()) {
+        cout << "(" << trace.total() - trace.size() << " earlier iterations not kept)\n";
     }
-
-    double c;
-    int iter = 0;
-
-    while (iter < maxIter && (b - a) / 2 > tol) {
-        c = (a + b) / 2;
-        double fc = f(c);
-
-        cout << setw(5) << iter + 1 
-             << setw(12) << fixed << setprecision(6) << a 
-             << setw(12) << b 
-             << setw(12) << c 
-             << setw(12) << fc << endl;
-
-        if (abs(fc) < 1e-10) break; 
-
-        if (f(a) * fc < 0) {
-            b = c; 
-        } else {
-            a = c; 
+    for (int i = 0; i < trace.size(); i++) {
+        const IterationRecord& r = trace[i];
+        cout << setw(5) << r.iteration << fixed << setprecision(6);
+        for (int k = 0; k < 4; k++) {
+            cout << setw(12) << r.values[k];
         }
-
-        iter++;
+        cout << "\n";
     }
-
-    cout << "\nAfter " << iter << " iterations:\n";
-    cout << "Approximate root: x = " << (a + b) / 2 << "\n";
-    cout << "Function value at root: f(x) = " << f((a + b) / 2) << "\n";
 }
 
-int main() {
+// argv[1], if given, replaces the built-in f, e.g. "x^3 - 2*x - 5".
+int main(int argc, char* argv[]) {
+    Expression expr;
+    if (argc > 1) {
+        string error;
+        if (!compileExpression(argv[1], expr, error)) {
+            cout << "Error: " << error << "\n";
+            return 1;
+        }
+    }
+
     double a, b, tol;
     int maxIter;
 
     cout << "Bisection Method for Root Finding\n";
-    cout << "Function: f(x) = x^3 - x - 2 (modify the f(x) function as needed)\n\n";
+    if (argc > 1) {
+        cout << "Function: f(x) = " << argv[1] << "\n\n";
+    } else {
+        cout << "Function: f(x) = x^3 - x - 2 (or pass f(x) as the first argument)\n\n";
+    }
     cout << "Enter the interval [a, b] where f(a) and f(b) have opposite signs:\n";
     cout << "a: ";
     cin >> a;
@@ -79,6 +75,23 @@ int main() {
         return 1;
     }
 
-    bisectionMethod(a, b, tol, maxIter);
+    printHeader(a, b, tol, maxIter);
+    JitExpression jit(expr);
+    IterationTrace trace;
+    RootResult result = timeSolve([&] { return bisectionMethod(argc > 1 ? FunctionRef(jit) : FunctionRef(f), a, b, tol, maxIter, trace); });
+    if (result.status == SolveStatus::InvalidBracket) {
+        cout << "Error: f(a) and f(b) must have opposite signs.\n";
+        return 1;
+    }
+    printIterations(trace);
+
+    cout << "\nAfter " << result.iterations << " iterations:\n";
+    cout << fixed << setprecision(6);
+    cout << "Approximate root: x = " << result.root << "\n";
+    cout << "Function value at root: f(x) = " << result.residual << "\n";
+    cout << "Function evaluations: " << result.evaluations << ", final bracket width: " << scientific << setprecision(3) << result.bracketWidth << ", time: " << fixed << setprecision(1) << result.seconds * 1e6 << " us\n";
+    if (result.status == SolveStatus::MaxIterations) {
+        cout << "Warning: " << statusMessage(result.status) << ".\n";
+    }
 
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <cmath>
+#include <iomanip>
+#include "expression-jit.h"
+#include "root-finding.h"
+
+using namespace std;
+
+double f(double x) {
+    return x * x * x - x - 2; 
+}
+
+void printHeader(double a, double b, double tol, int maxIter) {
+    cout << "\nBrent's Method for root finding:\n";
+    cout << "Initial interval: [" << a << ", " << b << "]\n";
+    cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n";
+}
+
+void printIterations(const IterationTrace& trace) {
+    cout << "\n" << setw(5) << "Iter" << setw(12) << "b(n-1)" << setw(12) << "c" << setw(12) << "b(n)" << setw(12) << "f(b(n))" << endl;
+    cout << string(60, '-') << endl;
+    if (trace.total() > (unsigned long long)trace.size()) {
+        cout << "(" << trace.total() - trace.size() << " earlier iterations not kept)\n";
+    }
+    for (int i = 0; i < trace.size(); i++) {
+        const IterationRecord& r = trace[i];
+        cout << setw(5) << r.iteration << fixed << setprecision(6);
+        for (int k = 0; k < 4; k++) {
+            cout << setw(12) << r.values[k];
+        }
+        cout << "\n";
+    }
+}
+
+// argv[1], if given, replaces the built-in f, e.g. "x^3 - 2*x - 5".
+int main(int argc, char* argv[]) {
+    Expression expr;
+    if (argc > 1) {
+        string error;
+        if (!compileExpression(argv[1], expr, error)) {
+            cout << "Error: " << error << "\n";
+            return 1;
+        }
+    }
+
+    double a, b, tol;
+    int maxIter;
+
+    cout << "Brent's Method for Root Finding\n";
+    if (argc > 1) {
+        cout << "Function: f(x) = " << argv[1] << "\n\n";
+    } else {
+        cout << "Function: f(x) = x^3 - x - 2 (or pass f(x) as the first argument)\n\n";
+    }
+    cout << "Enter the interval [a, b] where f(a) and f(b) have opposite signs:\n";
+    cout << "a: ";
+    cin >> a;
+    cout << "b: ";
+    cin >> b;
+    cout << "Enter the tolerance (e.g., 0.001): ";
+    cin >> tol;
+    cout << "Enter the maximum number of iterations (e.g., 20): ";
+    cin >> maxIter;
+
+    if (a >= b) {
+        cout << "Error: a must be less than b.\n";
+        return 1;
+    }
+    if (tol <= 0) {
+        cout << "Error: Tolerance must be positive.\n";
+        return 1;
+    }
+    if (maxIter <= 0) {
+        cout << "Error: Maximum iterations must be positive.\n";
+        return 1;
+    }
+
+    printHeader(a, b, tol, maxIter);
+    JitExpression jit(expr);
+    IterationTrace trace;
+    RootResult result = timeSolve([&] { return brentMethod(argc > 1 ? FunctionRef(jit) : FunctionRef(f), a, b, tol, maxIter, trace); });
+    if (result.status == SolveStatus::InvalidBracket) {
+        cout << "Error: f(a) and f(b) must have opposite signs.\n";
+        return 1;
+    }
+    printIterations(trace);
+
+    cout << "\nAfter " << result.iterations << " iterations:\n";
+    cout << fixed << setprecision(6);
+    cout << "Approximate root: x = " << result.root << "\n";
+    cout << "Function value at root: f(x) = " << result.residual << "\n";
+    cout << "Function evaluations: " << result.evaluations << ", final bracket width: " << scientific << setprecision(3) << result.bracketWidth << ", time: " << fixed << setprecision(1) << result.seconds * 1e6 << " us\n";
+    if (result.status == SolveStatus::MaxIterations) {
+        cout << "Warning: " << statusMessage(result.status) << ".\n";
+    }
+
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
+#include "expression-jit.h"
+#include "root-finding.h"
 
 using namespace std;
 
@@ -8,55 +11,65 @@ double f(double x) {
     return x * x * x - x - 2;
 }
 
-void falsePositionMethod(double a, double b, double tol, int maxIter) {
-    cout << "\nFalse Position Method for root finding:\n";
+void printHeader(const char* method, double a, double b, double tol, int maxIter) {
+    cout << "\n" << method << " for root finding:\n";
     cout << "Initial interval: [" << a << ", " << b << "]\n";
-    cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n\n";
-    cout << setw(5) << "Iter" << setw(12) << "a" << setw(12) << "b" 
-         << setw(12) << "c" << setw(12) << "f(c)" << endl;
-    cout << string(60, '-') << endl;
+    cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n";
+}
 
-    if (f(a) * f(b) >= 0) {
-        cout << "Error: f(a) and f(b) must have opposite signs.\n";
-        return;
+void printIterations(const IterationTrace& trace) {
+    cout << "\n" << setw(5) << "Iter" << setw(12) << "a" << setw(12) << "b" << setw(12) << "c" << setw(12) << "f(c)" << endl;
+    cout << string(60, '-') << endl;
+    if (trace.total() > (unsigned long long)trace.size()) {
+        cout << "(" << trace.total() - trace.size() << " earlier iterations not kept)\n";
     }
+    for (int i = 0; i < trace.size(); i++) {
+        const IterationRecord& r = trace[i];
+        cout << setw(5) << r.iteration << fixed << setprecision(6);
+        for (int k = 0; k < 4; k++) {
+            cout << setw(12) << r.values[k];
+        }
+        cout << "\n";
+    }
+}
 
-    double c;
-    int iter = 0;
-
-    while (iter < maxIter) {
-        
-        c = (a * f(b) - b * f(a)) / (f(b) - f(a));
-        double fc = f(c);
-
-        cout << setw(5) << iter + 1 
-             << setw(12) << fixed << setprecision(6) << a 
-             << setw(12) << b 
-             << setw(12) << c 
-             << setw(12) << fc << endl;
-
-        if (abs(fc) < tol || abs(b - a) < tol) break;
-
-        if (f(a) * fc < 0) {
-            b = c;
+// An argument other than the options below replaces the built-in f, e.g.
+// "x^3 - 2*x - 5". --illinois and --anderson-bjorck select the modified
+// regula falsi variants, which avoid the one-sided stalls of the plain method.
+int main(int argc, char* argv[]) {
+    const char* text = nullptr;
+    const char* method = "False Position Method";
+    int variant = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--illinois") == 0) {
+            variant = 1;
+            method = "Illinois Method";
+        } else if (strcmp(argv[i], "--anderson-bjorck") == 0) {
+            variant = 2;
+            method = "Anderson-Bjorck Method";
         } else {
-            a = c;
+            text = argv[i];
         }
-
-        iter++;
     }
 
-    cout << "\nAfter " << iter << " iterations:\n";
-    cout << "Approximate root: x = " << c << "\n";
-    cout << "Function value at root: f(x) = " << f(c) << "\n";
-}
+    Expression expr;
+    if (text) {
+        string error;
+        if (!compileExpression(text, expr, error)) {
+            cout << "Error: " << error << "\n";
+            return 1;
+        }
+    }
 
-int main() {
     double a, b, tol;
     int maxIter;
 
-    cout << "False Position Method for Root Finding\n";
-    cout << "Function: f(x) = x^3 - x - 2 (modify the f(x) function as needed)\n\n";
+    cout << method << " for Root Finding\n";
+    if (text) {
+        cout << "Function: f(x) = " << text << "\n\n";
+    } else {
+        cout << "Function: f(x) = x^3 - x - 2 (or pass f(x) as the first argument)\n\n";
+    }
 
     cout << "Enter the interval [a, b] where f(a) and f(b) have opposite signs:\n";
     cout << "a: ";
@@ -82,6 +95,28 @@ int main() {
         return 1;
     }
 
-    falsePositionMethod(a, b, tol, maxIter);
+    printHeader(method, a, b, tol, maxIter);
+    JitExpression jit(expr);
+    FunctionRef fn = text ? FunctionRef(jit) : FunctionRef(f);
+    IterationTrace trace;
+    RootResult result = timeSolve([&] {
+        if (variant == 1) return illinoisMethod(fn, a, b, tol, maxIter, trace);
+        if (variant == 2) return andersonBjorckMethod(fn, a, b, tol, maxIter, trace);
+        return falsePositionMethod(fn, a, b, tol, maxIter, trace);
+    });
+    if (result.status == SolveStatus::InvalidBracket) {
+        cout << "Error: f(a) and f(b) must have opposite signs.\n";
+        return 1;
+    }
+    printIterations(trace);
+
+    cout << "\nAfter " << result.iterations << " iterations:\n";
+    cout << fixed << setprecision(6);
+    cout << "Approximate root: x = " << result.root << "\n";
+    cout << "Function value at root: f(x) = " << result.residual << "\n";
+    cout << "Function evaluations: " << result.evaluations << ", final bracket width: " << scientific << setprecision(3) << result.bracketWidth << ", time: " << fixed << setprecision(1) << result.seconds * 1e6 << " us\n";
+    if (result.status == SolveStatus::MaxIterations) {
+        cout << "Warning: " << statusMessage(result.status) << ".\n";
+    }
 
 }
\ No newline at end of file
@@ -1,55 +1,69 @@
 #include <iostream>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <vector>
+#include "fixed-point.h"
+#include "root-finding.h"
 
 using namespace std;
 
-double evaluatePolynomial(const vector<double>& coeffs, double x) {
-    double result = 0.0;
-    for (int i = 0; i < coeffs.size(); i++) {
-        result += coeffs[i] * pow(x, coeffs.size() - 1 - i);
-    }
-    return result;
-}
-
-void fixedPointMethod(const vector<double>& coeffs, double x0, double tol, int maxIter) {
-    cout << "\nFixed Point Iteration for root finding:\n";
+void printHeader(const char* method, double x0, double tol, int maxIter) {
+    cout << "\n" << method << " for root finding:\n";
     cout << "Initial guess: x0 = " << x0 << "\n";
     cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n";
-    cout << "Using g(x) = x - f(x), where f(x) is the input polynomial\n\n";
-    cout << setw(5) << "Iter" << setw(12) << "xn" << setw(12) << "g(xn)" << setw(12) << "f(xn)" << endl;
-    cout << string(50, '-') << endl;
-
-    double x = x0;
-    int iter = 0;
-
-    while (iter < maxIter) {
-        double fx = evaluatePolynomial(coeffs, x);
-        double g_x = x - fx; 
-
-        cout << setw(5) << iter + 1 
-             << setw(12) << fixed << setprecision(6) << x 
-             << setw(12) << g_x 
-             << setw(12) << fx << endl;
-
-        if (abs(g_x - x) < tol || abs(fx) < tol) break;
+    cout << "Using g(x) = x - f(x), where f(x) is the input polynomial\n";
+}
 
-        x = g_x;
-        iter++;
+void printIterations(const IterationTrace& trace, const vector<const char*>& columns) {
+    cout << "\n" << setw(5) << "Iter";
+    for (const char* c : columns) {
+        cout << setw(12) << c;
+    }
+    cout << endl;
+    cout << string(5 + 12 * columns.size(), '-') << endl;
+    if (trace.total() > (unsigned long long)trace.size()) {
+        cout << "(" << trace.total() - trace.size() << " earlier iterations not kept)\n";
+    }
+    for (int i = 0; i < trace.size(); i++) {
+        const IterationRecord& r = trace[i];
+        cout << setw(5) << r.iteration << fixed << setprecision(6);
+        for (size_t k = 0; k < columns.size(); k++) {
+            cout << setw(12) << r.values[k];
+        }
+        cout << "\n";
     }
-
-    cout << "\nAfter " << iter << " iterations:\n";
-    cout << "Approximate root: x = " << x << "\n";
-    cout << "Function value at root: f(x) = " << evaluatePolynomial(coeffs, x) << "\n";
 }
 
-int main() {
+// --aitken, --steffensen and --anderson <depth> accelerate the iteration of
+// g(x) = x - f(x); Steffensen also converges where the plain iteration
+// diverges (|g'| > 1).
+int main(int argc, char* argv[]) {
+    const char* method = "Fixed Point Iteration";
+    int mode = 0, depth = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--aitken") == 0) {
+            mode = 1;
+            method = "Aitken-Accelerated Fixed Point Iteration";
+        } else if (strcmp(argv[i], "--steffensen") == 0) {
+            mode = 2;
+            method = "Steffensen's Method";
+        } else if (strcmp(argv[i], "--anderson") == 0 && i + 1 < argc) {
+            mode = 3;
+            depth = atoi(argv[++i]);
+            method = "Anderson-Accelerated Fixed Point Iteration";
+        } else {
+            cout << "Error: unknown option " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
     int degree;
     double x0, tol;
     int maxIter;
 
-    cout << "Fixed Point Iteration for Root Finding\n";
+    cout << method << " for Root Finding\n";
     cout << "Enter a polynomial f(x) = a_n x^n + ... + a_1 x + a_0 to solve f(x) = 0\n\n";
 
     cout << "Enter the degree of the polynomial: ";
@@ -85,5 +99,32 @@ int main() {
         return 1;
     }
 
-    fixedPointMethod(coeffs, x0, tol, maxIter);
+    printHeader(method, x0, tol, maxIter);
+    auto g = [&](double x) { return x - evaluatePolynomial(coeffs, x); };
+    IterationTrace trace;
+    RootResult result;
+    if (mode == 1) {
+        result = aitkenFixedPoint(g, x0, tol, maxIter, trace);
+        printIterations(trace, {"xn", "xn+1", "Aitken"});
+    } else if (mode == 2) {
+        result = steffensenFixedPoint(g, x0, tol, maxIter, trace);
+        printIterations(trace, {"xn", "g(xn)", "g(g(xn))", "xn+1"});
+    } else if (mode == 3) {
+        auto gv = [&](const vector<double>& x, vector<double>& gx) { gx[0] = g(x[0]); };
+        FixedPointSolution s = andersonFixedPoint(gv, {x0}, depth, tol, maxIter, trace);
+        result = {s.x[0], s.residual, s.iterations, s.status, s.evaluations, 0, 0};
+        printIterations(trace, {"|g(x)-x|", "history"});
+    } else {
+        result = fixedPointMethod(coeffs, x0, tol, maxIter, trace);
+        printIterations(trace, {"xn", "g(xn)", "f(xn)"});
+    }
+
+    cout << "\nAfter " << result.iterations << " iterations:\n";
+    cout << fixed << setprecision(6);
+    cout << "Approximate root: x = " << result.root << "\n";
+    cout << "Function value at root: f(x) = " << evaluatePolynomial(coeffs, result.root) << "\n";
+    cout << "Function evaluations: " << result.evaluations << "\n";
+    if (result.status != SolveStatus::Converged) {
+        cout << "Warning: " << statusMessage(result.status) << ".\n";
+    }
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <cmath>
 #include <iomanip>
+#include "expression-jit.h"
+#include "root-finding.h"
 
 using namespace std;
 
@@ -8,52 +10,48 @@ double f(double x) {
     return x * x * x - x - 2;
 }
 
-void secantMethod(double x0, double x1, double tol, int maxIter) {
+void printHeader(double x0, double x1, double tol, int maxIter) {
     cout << "\nSecant Method for root finding:\n";
     cout << "Initial guesses: x0 = " << x0 << ", x1 = " << x1 << "\n";
-    cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n\n";
-    cout << setw(5) << "Iter" << setw(12) << "xn-1" << setw(12) << "xn" 
-         << setw(12) << "f(xn)" << setw(12) << "xn+1" << endl;
-    cout << string(60, '-') << endl;
-
-    double xn_1 = x0, xn = x1;
-    int iter = 0;
-
-    while (iter < maxIter) {
-        double fxn = f(xn);
-        double fxn_1 = f(xn_1);
+    cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n";
+}
 
-        if (abs(fxn - fxn_1) < 1e-10) {
-            cout << "Error: f(xn) and f(xn-1) are too close, method fails.\n";
-            return;
+void printIterations(const IterationTrace& trace) {
+    cout << "\n" << setw(5) << "Iter" << setw(12) << "xn-1" << setw(12) << "xn" << setw(12) << "f(xn)" << setw(12) << "xn+1" << endl;
+    cout << string(60, '-') << endl;
+    if (trace.total() > (unsigned long long)trace.size()) {
+        cout << "(" << trace.total() - trace.size() << " earlier iterations not kept)\n";
+    }
+    for (int i = 0; i < trace.size(); i++) {
+        const IterationRecord& r = trace[i];
+        cout << setw(5) << r.iteration << fixed << setprecision(6);
+        for (int k = 0; k < 4; k++) {
+            cout << setw(12) << r.values[k];
         }
-
-        double xn1 = xn - fxn * (xn - xn_1) / (fxn - fxn_1);
-
-        cout << setw(5) << iter + 1 
-             << setw(12) << fixed << setprecision(6) << xn_1 
-             << setw(12) << xn 
-             << setw(12) << fxn 
-             << setw(12) << xn1 << endl;
-
-        if (abs(xn1 - xn) < tol || abs(fxn) < tol) break;
-
-        xn_1 = xn;
-        xn = xn1;
-        iter++;
+        cout << "\n";
     }
-
-    cout << "\nAfter " << iter << " iterations:\n";
-    cout << "Approximate root: x = " << xn << "\n";
-    cout << "Function value at root: f(x) = " << f(xn) << "\n";
 }
 
-int main() {
+// argv[1], if given, replaces the built-in f, e.g. "x^3 - 2*x - 5".
+int main(int argc, char* argv[]) {
+    Expression expr;
+    if (argc > 1) {
+        string error;
+        if (!compileExpression(argv[1], expr, error)) {
+            cout << "Error: " << error << "\n";
+            return 1;
+        }
+    }
+
     double x0, x1, tol;
     int maxIter;
 
     cout << "Secant Method for Root Finding\n";
-    cout << "Function: f(x) = x^3 - x - 2 (modify the f(x) function as needed)\n\n";
+    if (argc > 1) {
+        cout << "Function: f(x) = " << argv[1] << "\n\n";
+    } else {
+        cout << "Function: f(x) = x^3 - x - 2 (or pass f(x) as the first argument)\n\n";
+    }
     cout << "Enter the initial guesses x0 and x1:\n";
     cout << "x0: ";
     cin >> x0;
@@ -73,5 +71,22 @@ int main() {
         return 1;
     }
 
-    secantMethod(x0, x1, tol, maxIter);
+    printHeader(x0, x1, tol, maxIter);
+    JitExpression jit(expr);
+    IterationTrace trace;
+    RootResult result = secantMethod(argc > 1 ? FunctionRef(jit) : FunctionRef(f), x0, x1, tol, maxIter, trace);
+    printIterations(trace);
+    if (result.status == SolveStatus::ZeroDerivative) {
+        cout << "Error: f(xn) and f(xn-1) are too close, method fails.\n";
+        return 1;
+    }
+
+    cout << "\nAfter " << result.iterations << " iterations:\n";
+    cout << fixed << setprecision(6);
+    cout << "Approximate root: x = " << result.root << "\n";
+    cout << "Function value at root: f(x) = " << result.residual << "\n";
+    cout << "Function evaluations: " << result.evaluations << "\n";
+    if (result.status == SolveStatus::MaxIterations) {
+        cout << "Warning: " << statusMessage(result.status) << ".\n";
+    }
 }
\ No newline at end of file
@@ -0,0 +1,191 @@
+#ifndef BATCH_ROOTS_H
+#define BATCH_ROOTS_H
+
+#include <algorithm>
+#include <cstring>
+#include "batch-solver.h"
+#include "solve-status.h"
+
+// Bracketed root finding for many problems of one function family at once.
+// Problem s is f(x; params[s]) = 0 on [a[s], b[s]]. Problems are solved
+// BATCH_LANES at a time in lockstep, one SIMD lane each: f is evaluated on a
+// whole vector of x values, and a per-lane mask retires lanes as they
+// converge, so a group runs until its slowest lane is done.
+//
+// f is called as f(x, p) with x and p of type BatchLanes, so it must be
+// written with operations that work on GCC vectors, e.g. a generic lambda
+//
+//     [](auto x, auto p) { return x * x * x - x - p; }
+//
+// which also works for plain doubles. Results go to roots[s], iterations[s]
+// and status[s]; the return value is the number of problems that converged.
+// Built without -mavx512f, GCC notes (-Wpsabi) that such a lambda passes
+// 64-byte vectors; it is inlined into the kernels, so the note is harmless
+// and -Wno-psabi silences it.
+
+// Lane mask produced by comparing two BatchLanes: all ones where true.
+typedef decltype(BatchLanes() < BatchLanes()) BatchMask;
+
+// Loads up to BATCH_LANES values; the lanes past the end repeat the last one
+// so padding never evaluates f outside the caller's data.
+BATCH_INLINE void loadLanes(BatchLanes& v, const double* src, int lanes) {
+    if (lanes == BATCH_LANES) {
+        std::memcpy(&v, src, sizeof(BatchLanes));
+        return;
+    }
+    for (int l = 0; l < BATCH_LANES; l++) {
+        v[l] = src[std::min(l, lanes - 1)];
+    }
+}
+
+BATCH_INLINE bool anyLane(const BatchMask& m) {
+    for (int l = 0; l < BATCH_LANES; l++) {
+        if (m[l]) return true;
+    }
+    return false;
+}
+
+BATCH_INLINE void storeResults(const BatchLanes& root, const BatchMask& iters, const BatchMask& invalid, const BatchMask& converged, int lanes, double* roots, int* iterations, SolveStatus* status) {
+    for (int l = 0; l < lanes; l++) {
+        roots[l] = root[l];
+        iterations[l] = (int)iters[l];
+        status[l] = invalid[l] ? SolveStatus::InvalidBracket : converged[l] ? SolveStatus::Converged : SolveStatus::MaxIterations;
+    }
+}
+
+template <class F>
+BATCH_INLINE int bisectionGroups(F& f, const double* a, const double* b, const double* params, int count, double tol, int maxIter, double* roots, int* iterations, SolveStatus* status) {
+    int convergedCount = 0;
+    for (int s0 = 0; s0 < count; s0 += BATCH_LANES) {
+        int lanes = std::min(BATCH_LANES, count - s0);
+        BatchLanes lo, hi, p;
+        loadLanes(lo, a + s0, lanes);
+        loadLanes(hi, b + s0, lanes);
+        loadLanes(p, params + s0, lanes);
+
+        BatchLanes flo = f(lo, p);
+        BatchLanes fhi = f(hi, p);
+        BatchMask invalid = flo * fhi >= 0;
+        BatchMask active = ~invalid & ((hi - lo) / 2 > tol);
+        BatchMask iters = {};
+
+        for (int iter = 0; iter < maxIter && anyLane(active); iter++) {
+            BatchLanes c = (lo + hi) / 2;
+            BatchLanes fc = f(c, p);
+            iters -= active;
+
+            BatchLanes absFc = fc < 0 ? -fc : fc;
+            BatchMask exact = active & (absFc < 1e-10);
+            BatchMask left = active & ~exact & (flo * fc < 0);
+            BatchMask right = active & ~exact & ~left;
+            hi = (left | exact) ? c : hi;
+            lo = (right | exact) ? c : lo;
+            flo = right ? fc : flo;
+            active &= (hi - lo) / 2 > tol;
+        }
+
+        // Invalid lanes report a, as bisectionMethod does.
+        BatchLanes root = invalid ? lo : (lo + hi) / 2;
+        BatchMask converged = ~invalid & ((hi - lo) / 2 <= tol);
+        storeResults(root, iters, invalid, converged, lanes, roots + s0, iterations + s0, status + s0);
+        for (int l = 0; l < lanes; l++) {
+            convergedCount += converged[l] != 0;
+        }
+    }
+    return convergedCount;
+}
+
+// Regula falsi with the endpoint values carried between iterations.
+template <class F>
+BATCH_INLINE int falsePositionGroups(F& f, const double* a, const double* b, const double* params, int count, double tol, int maxIter, double* roots, int* iterations, SolveStatus* status) {
+    int convergedCount = 0;
+    for (int s0 = 0; s0 < count; s0 += BATCH_LANES) {
+        int lanes = std::min(BATCH_LANES, count - s0);
+        BatchLanes lo, hi, p;
+        loadLanes(lo, a + s0, lanes);
+        loadLanes(hi, b + s0, lanes);
+        loadLanes(p, params + s0, lanes);
+
+        BatchLanes flo = f(lo, p);
+        BatchLanes fhi = f(hi, p);
+        BatchMask invalid = flo * fhi >= 0;
+        BatchMask active = ~invalid;
+        BatchMask converged = {};
+        BatchMask iters = {};
+        BatchLanes root = lo;
+
+        for (int iter = 0; iter < maxIter && anyLane(active); iter++) {
+            BatchLanes c = (lo * fhi - hi * flo) / (fhi - flo);
+            BatchLanes fc = f(c, p);
+            iters -= active;
+            root = active ? c : root;
+
+            BatchLanes absFc = fc < 0 ? -fc : fc;
+            BatchLanes width = hi - lo;
+            BatchLanes absWidth = width < 0 ? -width : width;
+            BatchMask done = active & ((absFc < tol) | (absWidth < tol));
+            BatchMask left = active & ~done & (flo * fc < 0);
+            BatchMask right = active & ~done & ~left;
+            hi = left ? c : hi;
+            fhi = left ? fc : fhi;
+            lo = right ? c : lo;
+            flo = right ? fc : flo;
+            converged |= done;
+            active &= ~done;
+        }
+
+        storeResults(root, iters, invalid, converged, lanes, roots + s0, iterations + s0, status + s0);
+        for (int l = 0; l < lanes; l++) {
+            convergedCount += converged[l] != 0;
+        }
+    }
+    return convergedCount;
+}
+
+#ifdef ROW_KERNELS_X86
+template <class F>
+__attribute__((target("avx512f"))) int bisectionBatchAVX512(F& f, const double* a, const double* b, const double* params, int count, double tol, int maxIter, double* roots, int* iterations, SolveStatus* status) {
+    return bisectionGroups(f, a, b, params, count, tol, maxIter, roots, iterations, status);
+}
+
+template <class F>
+__attribute__((target("avx2,fma"))) int bisectionBatchAVX2(F& f, const double* a, const double* b, const double* params, int count, double tol, int maxIter, double* roots, int* iterations, SolveStatus* status) {
+    return bisectionGroups(f, a, b, params, count, tol, maxIter, roots, iterations, status);
+}
+
+template <class F>
+__attribute__((target("avx512f"))) int falsePositionBatchAVX512(F& f, const double* a, const double* b, const double* params, int count, double tol, int maxIter, double* roots, int* iterations, SolveStatus* status) {
+    return falsePositionGroups(f, a, b, params, count, tol, maxIter, roots, iterations, status);
+}
+
+template <class F>
+__attribute__((target("avx2,fma"))) int falsePositionBatchAVX2(F& f, const double* a, const double* b, const double* params, int count, double tol, int maxIter, double* roots, int* iterations, SolveStatus* status) {
+    return falsePositionGroups(f, a, b, params, count, tol, maxIter, roots, iterations, status);
+}
+#endif
+
+// Stops a lane when the half-width of its bracket is at most tol (or f hits
+// exactly zero), like bisectionMethod.
+template <class F>
+int bisectionBatch(F f, const double* a, const double* b, const double* params, int count, double tol, int maxIter, double* roots, int* iterations, SolveStatus* status) {
+#ifdef ROW_KERNELS_X86
+    static const SimdLevel level = detectSimdLevel();
+    if (level == SimdLevel::AVX512) return bisectionBatchAVX512(f, a, b, params, count, tol, maxIter, roots, iterations, status);
+    if (level == SimdLevel::AVX2) return bisectionBatchAVX2(f, a, b, params, count, tol, maxIter, roots, iterations, status);
+#endif
+    return bisectionGroups(f, a, b, params, count, tol, maxIter, roots, iterations, status);
+}
+
+// Stops a lane when |f(c)| < tol or the bracket is narrower than tol, like
+// falsePositionMethod.
+template <class F>
+int falsePositionBatch(F f, const double* a, const double* b, const double* params, int count, double tol, int maxIter, double* roots, int* iterations, SolveStatus* status) {
+#ifdef ROW_KERNELS_X86
+    static const SimdLevel level = detectSimdLevel();
+    if (level == SimdLevel::AVX512) return falsePositionBatchAVX512(f, a, b, params, count, tol, maxIter, roots, iterations, status);
+    if (level == SimdLevel::AVX2) return falsePositionBatchAVX2(f, a, b, params, count, tol, maxIter, roots, iterations, status);
+#endif
+    return falsePositionGroups(f, a, b, params, count, tol, maxIter, roots, iterations, status);
+}
+
+#endif
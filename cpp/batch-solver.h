@@ -0,0 +1,171 @@
+#ifndef BATCH_SOLVER_H
+#define BATCH_SOLVER_H
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "row-kernels.h"
+
+// Solves many independent N x N systems at once. The batch is stored as a
+// structure of arrays: element (i, j) of the augmented matrix of system s is
+// at augmented[(i * (N + 1) + j) * count + s] (column N holds b) and x[i] of
+// system s is written to x[i * count + s]. Systems are eliminated BATCH_LANES
+// at a time with partial pivoting, one SIMD lane per system: pivot search and
+// row swaps are per-lane selects, so no lane ever branches.
+
+const int BATCH_LANES = 8;
+
+// One double per system of a group, operated on as a single SIMD value.
+typedef double BatchLanes __attribute__((vector_size(BATCH_LANES * sizeof(double))));
+
+// The kernels are always inlined into the per-ISA entry points below so the
+// same source is compiled once for each instruction set.
+#define BATCH_INLINE inline __attribute__((always_inline))
+
+template <int N>
+BATCH_INLINE void solveBatchLanes(BatchLanes (&a)[N][N + 1], BatchLanes (&x)[N], BatchLanes& singular) {
+    BatchLanes zero = {};
+
+    for (int k = 0; k < N; k++) {
+        BatchLanes best = a[k][k] < 0 ? -a[k][k] : a[k][k];
+        BatchLanes piv = zero + k;
+        for (int i = k + 1; i < N; i++) {
+            BatchLanes v = a[i][k] < 0 ? -a[i][k] : a[i][k];
+            auto better = v > best;
+            best = better ? v : best;
+            piv = better ? zero + i : piv;
+        }
+        singular = best == 0 ? zero + 1 : singular;
+
+        // Row swap as a blend: row k trades places with row piv in each
+        // lane, leaving the other rows untouched.
+        for (int i = k + 1; i < N; i++) {
+            auto take = piv == i;
+            for (int j = k; j <= N; j++) {
+                BatchLanes top = a[k][j], other = a[i][j];
+                a[k][j] = take ? other : top;
+                a[i][j] = take ? top : other;
+            }
+        }
+
+        for (int i = k + 1; i < N; i++) {
+            BatchLanes factor = a[i][k] / a[k][k];
+            for (int j = k + 1; j <= N; j++) {
+                a[i][j] -= factor * a[k][j];
+            }
+        }
+    }
+
+    for (int i = N - 1; i >= 0; i--) {
+        BatchLanes sum = a[i][N];
+        for (int j = i + 1; j < N; j++) {
+            sum -= a[i][j] * x[j];
+        }
+        x[i] = sum / a[i][i];
+    }
+}
+
+template <int N>
+BATCH_INLINE int solveBatchGroups(const double* augmented, double* x, int count) {
+    const int W = BATCH_LANES;
+    BatchLanes a[N][N + 1];
+    BatchLanes xs[N];
+    int singularCount = 0;
+
+    for (int s0 = 0; s0 < count; s0 += W) {
+        int lanes = std::min(W, count - s0);
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j <= N; j++) {
+                const double* src = augmented + (std::size_t)(i * (N + 1) + j) * count + s0;
+                if (lanes == W) {
+                    std::memcpy(&a[i][j], src, sizeof(BatchLanes));
+                } else {
+                    // Pad the last partial group with identity systems.
+                    BatchLanes padded = {};
+                    for (int l = 0; l < W; l++) {
+                        padded[l] = l < lanes ? src[l] : (i == j ? 1.0 : 0.0);
+                    }
+                    a[i][j] = padded;
+                }
+            }
+        }
+
+        BatchLanes singular = {};
+        solveBatchLanes<N>(a, xs, singular);
+
+        for (int i = 0; i < N; i++) {
+            std::memcpy(x + (std::size_t)i * count + s0, &xs[i], lanes * sizeof(double));
+        }
+        for (int l = 0; l < lanes; l++) {
+            singularCount += singular[l] != 0;
+        }
+    }
+    return singularCount;
+}
+
+#ifdef ROW_KERNELS_X86
+template <int N>
+__attribute__((target("avx512f"))) int solveBatchAVX512(const double* augmented, double* x, int count) {
+    return solveBatchGroups<N>(augmented, x, count);
+}
+
+template <int N>
+__attribute__((target("avx2,fma"))) int solveBatchAVX2(const double* augmented, double* x, int count) {
+    return solveBatchGroups<N>(augmented, x, count);
+}
+#endif
+
+// Returns how many systems of the batch were singular; their x is inf/nan.
+template <int N>
+int solveBatch(const double* augmented, double* x, int count) {
+#ifdef ROW_KERNELS_X86
+    static const SimdLevel level = detectSimdLevel();
+    if (level == SimdLevel::AVX512) return solveBatchAVX512<N>(augmented, x, count);
+    if (level == SimdLevel::AVX2) return solveBatchAVX2<N>(augmented, x, count);
+#endif
+    return solveBatchGroups<N>(augmented, x, count);
+}
+
+// Runtime-size entry point for 1 <= n <= 16; returns -1 for other sizes.
+inline int solveSmallSystems(int n, const double* augmented, double* x, int count) {
+    switch (n) {
+    case 1: return solveBatch<1>(augmented, x, count);
+    case 2: return solveBatch<2>(augmented, x, count);
+    case 3: return solveBatch<3>(augmented, x, count);
+    case 4: return solveBatch<4>(augmented, x, count);
+    case 5: return solveBatch<5>(augmented, x, count);
+    case 6: return solveBatch<6>(augmented, x, count);
+    case 7: return solveBatch<7>(augmented, x, count);
+    case 8: return solveBatch<8>(augmented, x, count);
+    case 9: return solveBatch<9>(augmented, x, count);
+    case 10: return solveBatch<10>(augmented, x, count);
+    case 11: return solveBatch<11>(augmented, x, count);
+    case 12: return solveBatch<12>(augmented, x, count);
+    case 13: return solveBatch<13>(augmented, x, count);
+    case 14: return solveBatch<14>(augmented, x, count);
+    case 15: return solveBatch<15>(augmented, x, count);
+    case 16: return solveBatch<16>(augmented, x, count);
+    default: return -1;
+    }
+}
+
+// Owning structure-of-arrays batch of `count` augmented n x (n + 1) systems.
+class SystemBatch {
+public:
+    SystemBatch(int n, int count) : n(n), count(count), augmented((std::size_t)n * (n + 1) * count), x((std::size_t)n * count) {}
+
+    int size() const { return n; }
+    int systems() const { return count; }
+
+    double& a(int s, int i, int j) { return augmented[(std::size_t)(i * (n + 1) + j) * count + s]; }
+    double& b(int s, int i) { return a(s, i, n); }
+    double solution(int s, int i) const { return x[(std::size_t)i * count + s]; }
+
+    int solve() { return solveSmallSystems(n, augmented.data(), x.data(), count); }
+
+private:
+    int n, count;
+    std::vector<double> augmented, x;
+};
+
+#endif
@@ -1,9 +1,13 @@
 #include <iostream>
 #include <vector>
 #include <iomanip>
+#include "matrix.h"
+#include "matrix-io.h"
+#include "linear-solvers.h"
+
 using namespace std;
 
-void inputMatrix(vector<vector<double>>& matrix, int n) {
+void inputMatrix(Matrix& matrix, int n) {
     cout << "Enter the coefficients of the augmented matrix (n x n+1):\n";
     for (int i = 0; i < n; i++) {
         for (int j = 0; j <= n; j++) {
@@ -13,7 +17,7 @@ void inputMatrix(vector<vector<double>>& matrix, int n) {
     }
 }
 
-void printMatrix(const vector<vector<double>>& matrix, int n) {
+void printMatrix(const Matrix& matrix, int n) {
     for (int i = 0; i < n; i++) {
         for (int j = 0; j <= n; j++) {
             cout << setw(10) << matrix[i][j] << " ";
@@ -29,65 +33,30 @@ void printSolution(const vector<double>& x, int n) {
     }
 }
 
-double determinant(vector<vector<double>> matrix, int n) {
-    double det = 1;
-    for (int k = 0; k < n; k++) {
-        double pivot = matrix[k][k];
-        if (pivot == 0) return 0;
-        det *= pivot;
-        for (int j = k; j < n; j++) {
-            matrix[k][j] /= pivot;
-        }
-        for (int i = k + 1; i < n; i++) {
-            double factor = matrix[i][k];
-            for (int j = k; j < n; j++) {
-                matrix[i][j] -= factor * matrix[k][j];
-            }
-        }
-    }
-    return det;
-}
-
-void cramersRule(vector<vector<double>> matrix, int n) {
-    vector<double> x(n);
-    vector<vector<double>> temp(n, vector<double>(n));
+int main(int argc, char* argv[]) {
+    int n;
+    Matrix matrix;
     
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            temp[i][j] = matrix[i][j];
+    if (argc > 1) {
+        string error;
+        if (!readSystem(argv[1], matrix, n, error)) {
+            cout << "Error: " << error << "\n";
+            return 1;
         }
+    } else {
+        cout << "Enter the number of equations (n): ";
+        cin >> n;
+        matrix = Matrix(n, n + 1);
+        inputMatrix(matrix, n);
+        cout << "Augmented Matrix:\n";
+        printMatrix(matrix, n);
     }
-    
-    double detA = determinant(temp, n);
-    if (detA == 0) {
+    cout << "Cramer's Rule:\n";
+    LinearSolution result = cramersRule(matrix, n);
+    if (result.status == SolveStatus::Singular) {
         cout << "System has no unique solution (determinant is zero).\n";
-        return;
+    } else {
+        printSolution(result.x, n);
     }
     
-    for (int j = 0; j < n; j++) {
-        for (int i = 0; i < n; i++) {
-            for (int k = 0; k < n; k++) {
-                temp[i][k] = matrix[i][k];
-            }
-            temp[i][j] = matrix[i][n];
-        }
-        x[j] = determinant(temp, n) / detA;
-    }
-    
-    printSolution(x, n);
-}
-
-int main() {
-    int n;
-    cout << "Enter the number of equations (n): ";
-    cin >> n;
-    
-    vector<vector<double>> matrix(n, vector<double>(n + 1));
-    
-    inputMatrix(matrix, n);
-    cout << "Augmented Matrix:\n";
-    printMatrix(matrix, n);
-    cout << "Cramer's Rule:\n";
-    cramersRule(matrix, n);
-    
 }
\ No newline at end of file
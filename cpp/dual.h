@@ -0,0 +1,200 @@
+#ifndef DUAL_H
+#define DUAL_H
+
+#include <cmath>
+
+// Forward-mode automatic differentiation with dual numbers. A Dual<T> carries
+// a value and its derivative with respect to one input; every operation
+// applies the chain rule, so evaluating f at {x, 1} yields f(x) and f'(x)
+// together, exactly (up to rounding) and for one evaluation's cost.
+//
+// T is the scalar type: double for ordinary use, or Dual<double> to get
+// second derivatives as well.
+//
+// Functions to be differentiated are written generically, e.g.
+//
+//     [](auto x) { return x * sin(x) - 1; }
+//
+// calling the math functions unqualified so that the overloads here are
+// found for Dual arguments and the <cmath> ones for doubles.
+
+template <class T>
+struct Dual {
+    T value;
+    T derivative;
+
+    Dual() : value(), derivative() {}
+    Dual(T value) : value(value), derivative() {}
+    Dual(T value, T derivative) : value(value), derivative(derivative) {}
+
+    Dual& operator+=(const Dual& o) { return *this = *this + o; }
+    Dual& operator-=(const Dual& o) { return *this = *this - o; }
+    Dual& operator*=(const Dual& o) { return *this = *this * o; }
+    Dual& operator/=(const Dual& o) { return *this = *this / o; }
+};
+
+// The seed for differentiating at x: value x, dx/dx = 1.
+template <class T>
+Dual<T> variable(T x) {
+    return Dual<T>(x, T(1));
+}
+
+template <class T> Dual<T> operator+(const Dual<T>& a) { return a; }
+template <class T> Dual<T> operator-(const Dual<T>& a) { return Dual<T>(-a.value, -a.derivative); }
+
+template <class T> Dual<T> operator+(const Dual<T>& a, const Dual<T>& b) { return Dual<T>(a.value + b.value, a.derivative + b.derivative); }
+template <class T> Dual<T> operator-(const Dual<T>& a, const Dual<T>& b) { return Dual<T>(a.value - b.value, a.derivative - b.derivative); }
+template <class T> Dual<T> operator*(const Dual<T>& a, const Dual<T>& b) { return Dual<T>(a.value * b.value, a.derivative * b.value + a.value * b.derivative); }
+template <class T> Dual<T> operator/(const Dual<T>& a, const Dual<T>& b) {
+    T q = a.value / b.value;
+    return Dual<T>(q, (a.derivative - q * b.derivative) / b.value);
+}
+
+// Mixed forms with a plain scalar, which has derivative 0. The scalar is a
+// separate template parameter so that literals such as 2 or 0.5 convert.
+template <class T, class S> Dual<T> operator+(const Dual<T>& a, const S& s) { return Dual<T>(a.value + T(s), a.derivative); }
+template <class T, class S> Dual<T> operator+(const S& s, const Dual<T>& a) { return Dual<T>(T(s) + a.value, a.derivative); }
+template <class T, class S> Dual<T> operator-(const Dual<T>& a, const S& s) { return Dual<T>(a.value - T(s), a.derivative); }
+template <class T, class S> Dual<T> operator-(const S& s, const Dual<T>& a) { return Dual<T>(T(s) - a.value, -a.derivative); }
+template <class T, class S> Dual<T> operator*(const Dual<T>& a, const S& s) { return Dual<T>(a.value * T(s), a.derivative * T(s)); }
+template <class T, class S> Dual<T> operator*(const S& s, const Dual<T>& a) { return Dual<T>(T(s) * a.value, T(s) * a.derivative); }
+template <class T, class S> Dual<T> operator/(const Dual<T>& a, const S& s) { return Dual<T>(a.value / T(s), a.derivative / T(s)); }
+template <class T, class S> Dual<T> operator/(const S& s, const Dual<T>& a) {
+    T q = T(s) / a.value;
+    return Dual<T>(q, -q * a.derivative / a.value);
+}
+
+// Comparisons look at the value only, so branching code differentiates the
+// branch that was taken.
+template <class T> bool operator<(const Dual<T>& a, const Dual<T>& b) { return a.value < b.value; }
+template <class T> bool operator>(const Dual<T>& a, const Dual<T>& b) { return a.value > b.value; }
+template <class T> bool operator<=(const Dual<T>& a, const Dual<T>& b) { return a.value <= b.value; }
+template <class T> bool operator>=(const Dual<T>& a, const Dual<T>& b) { return a.value >= b.value; }
+template <class T> bool operator==(const Dual<T>& a, const Dual<T>& b) { return a.value == b.value; }
+template <class T> bool operator!=(const Dual<T>& a, const Dual<T>& b) { return a.value != b.value; }
+template <class T, class S> bool operator<(const Dual<T>& a, const S& s) { return a.value < T(s); }
+template <class T, class S> bool operator>(const Dual<T>& a, const S& s) { return a.value > T(s); }
+template <class T, class S> bool operator<=(const Dual<T>& a, const S& s) { return a.value <= T(s); }
+template <class T, class S> bool operator>=(const Dual<T>& a, const S& s) { return a.value >= T(s); }
+template <class T, class S> bool operator==(const Dual<T>& a, const S& s) { return a.value == T(s); }
+template <class T, class S> bool operator!=(const Dual<T>& a, const S& s) { return a.value != T(s); }
+template <class T, class S> bool operator<(const S& s, const Dual<T>& a) { return T(s) < a.value; }
+template <class T, class S> bool operator>(const S& s, const Dual<T>& a) { return T(s) > a.value; }
+template <class T, class S> bool operator<=(const S& s, const Dual<T>& a) { return T(s) <= a.value; }
+template <class T, class S> bool operator>=(const S& s, const Dual<T>& a) { return T(s) >= a.value; }
+template <class T, class S> bool operator==(const S& s, const Dual<T>& a) { return T(s) == a.value; }
+template <class T, class S> bool operator!=(const S& s, const Dual<T>& a) { return T(s) != a.value; }
+
+// f(u) with f(u.value) = v and f'(u.value) = d.
+template <class T>
+Dual<T> chain(const Dual<T>& u, const T& v, const T& d) {
+    return Dual<T>(v, d * u.derivative);
+}
+
+template <class T> Dual<T> sin(const Dual<T>& u) {
+    using std::cos; using std::sin;
+    return chain(u, T(sin(u.value)), T(cos(u.value)));
+}
+template <class T> Dual<T> cos(const Dual<T>& u) {
+    using std::cos; using std::sin;
+    return chain(u, T(cos(u.value)), T(-sin(u.value)));
+}
+template <class T> Dual<T> tan(const Dual<T>& u) {
+    using std::tan;
+    T t = tan(u.value);
+    return chain(u, t, T(1 + t * t));
+}
+template <class T> Dual<T> asin(const Dual<T>& u) {
+    using std::asin; using std::sqrt;
+    return chain(u, T(asin(u.value)), T(1 / sqrt(1 - u.value * u.value)));
+}
+template <class T> Dual<T> acos(const Dual<T>& u) {
+    using std::acos; using std::sqrt;
+    return chain(u, T(acos(u.value)), T(-1 / sqrt(1 - u.value * u.value)));
+}
+template <class T> Dual<T> atan(const Dual<T>& u) {
+    using std::atan;
+    return chain(u, T(atan(u.value)), T(1 / (1 + u.value * u.value)));
+}
+template <class T> Dual<T> sinh(const Dual<T>& u) {
+    using std::cosh; using std::sinh;
+    return chain(u, T(sinh(u.value)), T(cosh(u.value)));
+}
+template <class T> Dual<T> cosh(const Dual<T>& u) {
+    using std::cosh; using std::sinh;
+    return chain(u, T(cosh(u.value)), T(sinh(u.value)));
+}
+template <class T> Dual<T> tanh(const Dual<T>& u) {
+    using std::tanh;
+    T t = tanh(u.value);
+    return chain(u, t, T(1 - t * t));
+}
+template <class T> Dual<T> exp(const Dual<T>& u) {
+    using std::exp;
+    T e = exp(u.value);
+    return chain(u, e, e);
+}
+template <class T> Dual<T> log(const Dual<T>& u) {
+    using std::log;
+    return chain(u, T(log(u.value)), T(1 / u.value));
+}
+template <class T> Dual<T> log10(const Dual<T>& u) {
+    using std::log10;
+    return chain(u, T(log10(u.value)), T(1 / (u.value * 2.302585092994045684)));
+}
+template <class T> Dual<T> log2(const Dual<T>& u) {
+    using std::log2;
+    return chain(u, T(log2(u.value)), T(1 / (u.value * 0.693147180559945309)));
+}
+template <class T> Dual<T> sqrt(const Dual<T>& u) {
+    using std::sqrt;
+    T s = sqrt(u.value);
+    return chain(u, s, T(0.5 / s));
+}
+template <class T> Dual<T> cbrt(const Dual<T>& u) {
+    using std::cbrt;
+    T c = cbrt(u.value);
+    return chain(u, c, T(1 / (3 * c * c)));
+}
+template <class T> Dual<T> abs(const Dual<T>& u) {
+    return u.value < 0 ? -u : u;
+}
+template <class T> Dual<T> fabs(const Dual<T>& u) {
+    return abs(u);
+}
+// Piecewise constant: derivative 0 wherever it exists.
+template <class T> Dual<T> floor(const Dual<T>& u) {
+    using std::floor;
+    return Dual<T>(floor(u.value));
+}
+template <class T> Dual<T> ceil(const Dual<T>& u) {
+    using std::ceil;
+    return Dual<T>(ceil(u.value));
+}
+
+template <class T> Dual<T> pow(const Dual<T>& u, double e) {
+    using std::pow;
+    return chain(u, T(pow(u.value, e)), T(e * pow(u.value, e - 1)));
+}
+template <class T> Dual<T> pow(const Dual<T>& u, const Dual<T>& v) {
+    using std::log; using std::pow;
+    T p = pow(u.value, v.value);
+    // d(u^v) = v u^(v-1) du + u^v ln(u) dv; the ln term is dropped for
+    // u <= 0, where u^v is only defined for integer v.
+    T du = v.value * pow(u.value, v.value - 1) * u.derivative;
+    T dv = u.value > 0 ? T(p * log(u.value) * v.derivative) : T(0);
+    return Dual<T>(p, du + dv);
+}
+template <class T> Dual<T> pow(double b, const Dual<T>& v) {
+    using std::log; using std::pow;
+    T p = pow(T(b), v.value);
+    return Dual<T>(p, p * log(T(b)) * v.derivative);
+}
+
+// f(x) and f'(x) from one evaluation of a generic callable.
+template <class F>
+Dual<double> differentiate(F&& f, double x) {
+    return f(variable(x));
+}
+
+#endif
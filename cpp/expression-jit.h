@@ -0,0 +1,406 @@
+#ifndef EXPRESSION_JIT_H
+#define EXPRESSION_JIT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "expression.h"
+#include "row-kernels.h"
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define EXPRESSION_JIT_X86_64
+#include <sys/mman.h>
+#endif
+
+// Native-code backend for Expression. The stack program is translated
+// instruction by instruction into x86-64 machine code: a scalar SSE2 function
+// double(double) and, when the program needs no library calls, an AVX loop
+// that evaluates four points per iteration for evaluate(). The stack top
+// lives in xmm0/ymm0, x in xmm1/ymm1 and the rest of the operand stack in the
+// function's frame; sin, exp, pow and friends are called through libm.
+//
+// On other platforms, or if executable memory cannot be mapped, JitExpression
+// silently evaluates with the interpreter, so callers never need a second
+// code path.
+
+class JitExpression {
+public:
+    explicit JitExpression(const Expression& expr, bool enable = true) : expr(expr) {
+#ifdef EXPRESSION_JIT_X86_64
+        if (enable) build();
+#else
+        (void)enable;
+#endif
+    }
+
+    ~JitExpression() { release(); }
+
+    JitExpression(const JitExpression&) = delete;
+    JitExpression& operator=(const JitExpression&) = delete;
+
+    bool compiled() const { return scalar != nullptr; }
+    bool vectorized() const { return vector != nullptr; }
+
+    double operator()(double x) const { return scalar ? scalar(x) : expr(x); }
+
+    // out[i] = f(x[i]) for i < n.
+    void evaluate(const double* x, double* out, std::size_t n) const {
+        std::size_t i = 0;
+        if (vector) {
+            vector(x, out, n / 4);
+            i = n / 4 * 4;
+        }
+        for (; i < n; i++) {
+            out[i] = (*this)(x[i]);
+        }
+    }
+
+private:
+    void release() {
+#ifdef EXPRESSION_JIT_X86_64
+        if (memory) munmap(memory, memorySize);
+#endif
+        memory = nullptr;
+        scalar = nullptr;
+        vector = nullptr;
+    }
+
+#ifdef EXPRESSION_JIT_X86_64
+    typedef Expression E;
+
+    // Register roles shared by both code shapes.
+    enum { TOP = 0, XREG = 1, T1 = 2, T2 = 3 };
+    // SSE/AVX opcodes (second byte after 0F).
+    enum { LOAD = 0x10, STORE = 0x11, MOVE = 0x28, SQRT = 0x51, AND = 0x54, XOR = 0x57, ADD = 0x58, MUL = 0x59, SUB = 0x5C, DIV = 0x5E };
+
+    struct Assembler {
+        std::vector<unsigned char> code;
+        std::vector<double> pool;
+        bool wide = false;  // AVX ymm (4 doubles) instead of scalar SSE2
+        std::size_t poolBytes = 0;
+
+        void byte(int b) { code.push_back((unsigned char)b); }
+        void u32(std::uint32_t v) {
+            for (int i = 0; i < 4; i++) byte(v >> (8 * i));
+        }
+        void u64(std::uint64_t v) {
+            for (int i = 0; i < 8; i++) byte((int)(v >> (8 * i)));
+        }
+        std::size_t here() const { return poolBytes + code.size(); }
+
+        int constant(double v) {
+            for (std::size_t i = 0; i < pool.size(); i++) {
+                if (std::memcmp(&pool[i], &v, sizeof(double)) == 0) return (int)i;
+            }
+            pool.push_back(v);
+            return (int)pool.size() - 1;
+        }
+
+        // Prefix and opcode for register-form `op`; vvvv is the first source
+        // of a VEX three-operand form (0 when unused).
+        void prefix(int op, int vvvv) {
+            if (wide) {
+                byte(0xC5);
+                byte(0x80 | ((~vvvv & 15) << 3) | 0x04 | 0x01);
+            } else {
+                bool packedOnly = op == MOVE || op == AND || op == XOR;
+                byte(packedOnly ? 0x66 : 0xF2);
+                byte(0x0F);
+            }
+            byte(op);
+        }
+
+        static bool threeOperand(int op) { return op == ADD || op == MUL || op == SUB || op == DIV || op == AND || op == XOR; }
+
+        // dst = dst op src (or dst = op src for moves and sqrt).
+        void rr(int op, int dst, int src) {
+            prefix(op, threeOperand(op) ? dst : 0);
+            byte(0xC0 | (dst << 3) | src);
+        }
+
+        // reg op= [rsp + disp], or load/store between reg and [rsp + disp].
+        void stack(int op, int reg, int disp) {
+            prefix(op, threeOperand(op) ? reg : 0);
+            byte(0x84 | (reg << 3));
+            byte(0x24);
+            u32(disp);
+        }
+
+        // reg = constant, broadcast to every lane.
+        void loadConstant(int reg, double v) {
+            int index = constant(v);
+            if (wide) {
+                byte(0xC4);
+                byte(0xE2);
+                byte(0x7D);
+                byte(0x19);  // vbroadcastsd ymm, m64
+            } else {
+                byte(0xF2);
+                byte(0x0F);
+                byte(LOAD);
+            }
+            byte(0x05 | (reg << 3));
+            u32((std::uint32_t)(index * 8 - (std::int64_t)(here() + 4)));
+        }
+
+        void adjustStack(bool add, int bytes) {
+            byte(0x48);
+            byte(0x81);
+            byte(add ? 0xC4 : 0xEC);
+            u32(bytes);
+        }
+
+        void callAbsolute(const void* fn) {
+            byte(0x48);
+            byte(0xB8);  // mov rax, imm64
+            u64((std::uint64_t)(std::uintptr_t)fn);
+            byte(0xFF);
+            byte(0xD0);  // call rax
+        }
+    };
+
+    static const void* libraryFunction(E::Op op) {
+        typedef double (*Unary)(double);
+        switch (op) {
+        case E::Sin: return (const void*)(Unary)[](double v) { return std::sin(v); };
+        case E::Cos: return (const void*)(Unary)[](double v) { return std::cos(v); };
+        case E::Tan: return (const void*)(Unary)[](double v) { return std::tan(v); };
+        case E::Asin: return (const void*)(Unary)[](double v) { return std::asin(v); };
+        case E::Acos: return (const void*)(Unary)[](double v) { return std::acos(v); };
+        case E::Atan: return (const void*)(Unary)[](double v) { return std::atan(v); };
+        case E::Sinh: return (const void*)(Unary)[](double v) { return std::sinh(v); };
+        case E::Cosh: return (const void*)(Unary)[](double v) { return std::cosh(v); };
+        case E::Tanh: return (const void*)(Unary)[](double v) { return std::tanh(v); };
+        case E::Exp: return (const void*)(Unary)[](double v) { return std::exp(v); };
+        case E::Log: return (const void*)(Unary)[](double v) { return std::log(v); };
+        case E::Log10: return (const void*)(Unary)[](double v) { return std::log10(v); };
+        case E::Log2: return (const void*)(Unary)[](double v) { return std::log2(v); };
+        case E::Cbrt: return (const void*)(Unary)[](double v) { return std::cbrt(v); };
+        case E::Floor: return (const void*)(Unary)[](double v) { return std::floor(v); };
+        case E::Ceil: return (const void*)(Unary)[](double v) { return std::ceil(v); };
+        case E::Pow:
+        case E::PowC: return (const void*)(double (*)(double, double))[](double a, double b) { return std::pow(a, b); };
+        default: return nullptr;
+        }
+    }
+
+    static int maxDepth(const std::vector<E::Instruction>& program) {
+        int depth = 0, deepest = 0;
+        for (const E::Instruction& in : program) {
+            if (in.op == E::Const || in.op == E::X) depth++;
+            if (in.op >= E::Add && in.op <= E::Pow) depth--;
+            if (depth > deepest) deepest = depth;
+        }
+        return deepest;
+    }
+
+    // Emits the program body. Operand stack entry i below the top is at
+    // [rsp + i * slot]; xSlot (scalar code only) keeps x across calls.
+    static bool emitBody(Assembler& a, const std::vector<E::Instruction>& program, int slot, int xSlot) {
+        int depth = 0;
+        for (const E::Instruction& in : program) {
+            switch (in.op) {
+            case E::Const:
+            case E::X:
+                if (depth > 0) a.stack(STORE, TOP, (depth - 1) * slot);
+                if (in.op == E::Const) {
+                    a.loadConstant(TOP, in.value);
+                } else {
+                    a.rr(MOVE, TOP, XREG);
+                }
+                depth++;
+                break;
+            case E::Add:
+            case E::Mul:
+                a.stack(in.op == E::Add ? ADD : MUL, TOP, (depth - 2) * slot);
+                depth--;
+                break;
+            case E::Sub:
+            case E::Div:
+                a.stack(LOAD, T1, (depth - 2) * slot);
+                a.rr(in.op == E::Sub ? SUB : DIV, T1, TOP);
+                a.rr(MOVE, TOP, T1);
+                depth--;
+                break;
+            case E::AddC:
+            case E::SubC:
+            case E::MulC:
+            case E::DivC:
+                a.loadConstant(T1, in.value);
+                a.rr(in.op == E::AddC ? ADD : in.op == E::SubC ? SUB : in.op == E::MulC ? MUL : DIV, TOP, T1);
+                break;
+            case E::ConstSub:
+            case E::ConstDiv:
+                a.loadConstant(T1, in.value);
+                a.rr(in.op == E::ConstSub ? SUB : DIV, T1, TOP);
+                a.rr(MOVE, TOP, T1);
+                break;
+            case E::AddX:
+            case E::SubX:
+            case E::MulX:
+            case E::DivX:
+                a.rr(in.op == E::AddX ? ADD : in.op == E::SubX ? SUB : in.op == E::MulX ? MUL : DIV, TOP, XREG);
+                break;
+            case E::XSub:
+            case E::XDiv:
+                a.rr(MOVE, T1, XREG);
+                a.rr(in.op == E::XSub ? SUB : DIV, T1, TOP);
+                a.rr(MOVE, TOP, T1);
+                break;
+            case E::Neg:
+                a.loadConstant(T1, -0.0);
+                a.rr(XOR, TOP, T1);
+                break;
+            case E::Abs: {
+                std::uint64_t bits = 0x7FFFFFFFFFFFFFFFull;
+                double mask;
+                std::memcpy(&mask, &bits, sizeof(mask));
+                a.loadConstant(T1, mask);
+                a.rr(AND, TOP, T1);
+                break;
+            }
+            case E::Square:
+                a.rr(MUL, TOP, TOP);
+                break;
+            case E::Cube:
+                a.rr(MOVE, T1, TOP);
+                a.rr(MUL, TOP, TOP);
+                a.rr(MUL, TOP, T1);
+                break;
+            case E::PowInt:
+                emitPowInt(a, in.n);
+                break;
+            case E::Sqrt:
+                a.rr(SQRT, TOP, TOP);
+                break;
+            default:
+                // Library calls; only the scalar code can make them.
+                if (xSlot < 0) return false;
+                if (in.op == E::Pow) {
+                    a.rr(MOVE, XREG, TOP);
+                    a.stack(LOAD, TOP, (depth - 2) * slot);
+                    depth--;
+                } else if (in.op == E::PowC) {
+                    a.loadConstant(XREG, in.value);
+                }
+                a.callAbsolute(libraryFunction(in.op));
+                a.stack(LOAD, XREG, xSlot);
+                break;
+            }
+        }
+        return true;
+    }
+
+    // TOP = TOP^n by square-and-multiply, unrolled for the known n.
+    static void emitPowInt(Assembler& a, int n) {
+        if (n == 0) {
+            a.loadConstant(TOP, 1.0);
+            return;
+        }
+        unsigned e = n < 0 ? -(unsigned)n : (unsigned)n;
+        bool started = false;
+        a.rr(MOVE, T1, TOP);
+        while (e) {
+            if (e & 1) {
+                if (started) {
+                    a.rr(MUL, T2, T1);
+                } else {
+                    a.rr(MOVE, T2, T1);
+                    started = true;
+                }
+            }
+            e >>= 1;
+            if (e) a.rr(MUL, T1, T1);
+        }
+        if (n < 0) {
+            a.loadConstant(TOP, 1.0);
+            a.rr(DIV, TOP, T2);
+        } else {
+            a.rr(MOVE, TOP, T2);
+        }
+    }
+
+    // double f(double x): x arrives and the result leaves in xmm0.
+    static void emitScalar(Assembler& a, const std::vector<E::Instruction>& program, int depth) {
+        int xSlot = depth * 8;
+        int frame = xSlot + 8;
+        if (frame % 16 == 0) frame += 8;  // keeps calls 16-byte aligned
+        a.adjustStack(false, frame);
+        a.stack(STORE, TOP, xSlot);
+        a.rr(MOVE, XREG, TOP);
+        emitBody(a, program, 8, xSlot);
+        a.adjustStack(true, frame);
+        a.byte(0xC3);
+    }
+
+    // void f(const double* x [rdi], double* out [rsi], size_t blocks [rdx])
+    // evaluating four points per block.
+    static bool emitVector(Assembler& a, const std::vector<E::Instruction>& program, int depth) {
+        int frame = depth * 32;
+        a.adjustStack(false, frame);
+        std::size_t top = a.code.size();
+        a.byte(0x48); a.byte(0x85); a.byte(0xD2);  // test rdx, rdx
+        a.byte(0x0F); a.byte(0x84);                // jz done
+        std::size_t exitPatch = a.code.size();
+        a.u32(0);
+        a.byte(0xC5); a.byte(0xFD); a.byte(LOAD); a.byte(0x0F);  // vmovupd ymm1, [rdi]
+        if (!emitBody(a, program, 32, -1)) return false;
+        a.byte(0xC5); a.byte(0xFD); a.byte(STORE); a.byte(0x06);  // vmovupd [rsi], ymm0
+        a.byte(0x48); a.byte(0x83); a.byte(0xC7); a.byte(32);     // add rdi, 32
+        a.byte(0x48); a.byte(0x83); a.byte(0xC6); a.byte(32);     // add rsi, 32
+        a.byte(0x48); a.byte(0xFF); a.byte(0xCA);                 // dec rdx
+        a.byte(0xE9);                                             // jmp top
+        a.u32((std::uint32_t)((std::int64_t)top - (std::int64_t)(a.code.size() + 4)));
+        std::uint32_t exit = (std::uint32_t)(a.code.size() - (exitPatch + 4));
+        std::memcpy(&a.code[exitPatch], &exit, 4);
+        a.adjustStack(true, frame);
+        a.byte(0xC5); a.byte(0xF8); a.byte(0x77);  // vzeroupper
+        a.byte(0xC3);
+        return true;
+    }
+
+    void build() {
+        const std::vector<E::Instruction>& program = expr.program();
+        if (program.empty()) return;
+        int depth = maxDepth(program);
+
+        // Constants are gathered on a first pass so the pool, which sits in
+        // front of the code, has its final size when the code is emitted.
+        Assembler probe;
+        emitScalar(probe, program, depth);
+        probe.wide = true;
+        bool wide = detectSimdLevel() >= SimdLevel::AVX2 && emitVector(probe, program, depth);
+
+        Assembler a;
+        a.pool = probe.pool;
+        a.poolBytes = (probe.pool.size() * 8 + 15) / 16 * 16;
+        emitScalar(a, program, depth);
+        std::size_t vectorStart = a.code.size();
+        a.wide = true;
+        if (wide) emitVector(a, program, depth);
+
+        memorySize = a.poolBytes + a.code.size();
+        void* p = mmap(nullptr, memorySize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) return;
+        unsigned char* bytes = static_cast<unsigned char*>(p);
+        std::memcpy(bytes, a.pool.data(), a.pool.size() * 8);
+        std::memcpy(bytes + a.poolBytes, a.code.data(), a.code.size());
+        if (mprotect(p, memorySize, PROT_READ | PROT_EXEC) != 0) {
+            munmap(p, memorySize);
+            return;
+        }
+        memory = p;
+        scalar = reinterpret_cast<double (*)(double)>(bytes + a.poolBytes);
+        if (wide) vector = reinterpret_cast<void (*)(const double*, double*, std::size_t)>(bytes + a.poolBytes + vectorStart);
+    }
+#endif
+
+    Expression expr;
+    void* memory = nullptr;
+    std::size_t memorySize = 0;
+    double (*scalar)(double) = nullptr;
+    void (*vector)(const double*, double*, std::size_t) = nullptr;
+};
+
+#endif
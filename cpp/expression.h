@@ -0,0 +1,403 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Runtime-defined functions of x, e.g. "x^3 - x - 2" or "sqrt(1.8*x+2.5)".
+// compileExpression parses the text once into a flat stack-machine program;
+// evaluating it is a single loop over the instructions with the operand
+// stack in a fixed local array, so there is no allocation or tree walking
+// per call. While compiling, constant subexpressions are folded, binary
+// operations with a constant or x operand become one instruction, and integer
+// powers become multiplications.
+//
+// Grammar: numbers, x, pi, e, + - * / ^ (right associative, binding tighter
+// than unary minus), parentheses, implicit multiplication ("2x", "3(x+1)")
+// and the functions sin cos tan asin acos atan sinh cosh tanh exp log/ln
+// log10 log2 sqrt cbrt abs floor ceil.
+
+const int EXPRESSION_MAX_DEPTH = 32;
+// Recursion levels the parser allows (a parenthesis takes two, a unary sign
+// one), so hostile input fails cleanly instead of overflowing the C++ stack.
+const int EXPRESSION_MAX_NESTING = 256;
+
+class Expression {
+public:
+    enum Op : unsigned char {
+        Const, X,
+        Add, Sub, Mul, Div, Pow,
+        AddC, SubC, MulC, DivC, PowC, ConstSub, ConstDiv,
+        AddX, SubX, MulX, DivX, XSub, XDiv,
+        Neg, Square, Cube, PowInt,
+        Sin, Cos, Tan, Asin, Acos, Atan, Sinh, Cosh, Tanh,
+        Exp, Log, Log10, Log2, Sqrt, Cbrt, Abs, Floor, Ceil,
+    };
+
+    struct Instruction {
+        Op op;
+        int n;         // exponent for PowInt
+        double value;  // constant for Const and the *C forms
+    };
+
+    // T is double, or any type with arithmetic and unqualified math functions,
+    // e.g. Dual<double> (dual.h) to get f'(x) in the same pass. An empty
+    // program (a default-constructed Expression) evaluates to 0.
+    template <class T>
+    T operator()(T x) const {
+        using std::pow;
+        if (code.empty()) return T();
+        T stack[EXPRESSION_MAX_DEPTH];
+        T* top = stack - 1;
+        for (const Instruction& in : code) {
+            switch (in.op) {
+            case Const: *++top = in.value; break;
+            case X: *++top = x; break;
+            case Add: top[-1] += top[0]; top--; break;
+            case Sub: top[-1] -= top[0]; top--; break;
+            case Mul: top[-1] *= top[0]; top--; break;
+            case Div: top[-1] /= top[0]; top--; break;
+            case Pow: top[-1] = pow(top[-1], top[0]); top--; break;
+            case AddC: *top += in.value; break;
+            case SubC: *top -= in.value; break;
+            case MulC: *top *= in.value; break;
+            case DivC: *top /= in.value; break;
+            case PowC: *top = pow(*top, in.value); break;
+            case ConstSub: *top = in.value - *top; break;
+            case ConstDiv: *top = in.value / *top; break;
+            case AddX: *top += x; break;
+            case SubX: *top -= x; break;
+            case MulX: *top *= x; break;
+            case DivX: *top /= x; break;
+            case XSub: *top = x - *top; break;
+            case XDiv: *top = x / *top; break;
+            default: *top = apply(in, *top); break;
+            }
+        }
+        return *top;
+    }
+
+    const std::vector<Instruction>& program() const { return code; }
+
+    // Unary instructions, shared by evaluation and constant folding.
+    template <class T>
+    static T apply(const Instruction& in, T v) {
+        using std::sin; using std::cos; using std::tan; using std::asin; using std::acos; using std::atan;
+        using std::sinh; using std::cosh; using std::tanh; using std::exp; using std::log; using std::log10;
+        using std::log2; using std::sqrt; using std::cbrt; using std::abs; using std::floor; using std::ceil;
+        switch (in.op) {
+        case Neg: return -v;
+        case Square: return v * v;
+        case Cube: return v * v * v;
+        case PowInt: return powInt(v, in.n);
+        case Sin: return sin(v);
+        case Cos: return cos(v);
+        case Tan: return tan(v);
+        case Asin: return asin(v);
+        case Acos: return acos(v);
+        case Atan: return atan(v);
+        case Sinh: return sinh(v);
+        case Cosh: return cosh(v);
+        case Tanh: return tanh(v);
+        case Exp: return exp(v);
+        case Log: return log(v);
+        case Log10: return log10(v);
+        case Log2: return log2(v);
+        case Sqrt: return sqrt(v);
+        case Cbrt: return cbrt(v);
+        case Abs: return abs(v);
+        case Floor: return floor(v);
+        case Ceil: return ceil(v);
+        default: return v;
+        }
+    }
+
+    template <class T>
+    static T powInt(T v, int n) {
+        bool invert = n < 0;
+        unsigned e = invert ? -(unsigned)n : (unsigned)n;
+        T result = 1;
+        while (e) {
+            if (e & 1) result *= v;
+            v *= v;
+            e >>= 1;
+        }
+        return invert ? 1 / result : result;
+    }
+
+private:
+    friend class ExpressionCompiler;
+    std::vector<Instruction> code;
+};
+
+class ExpressionCompiler {
+public:
+    ExpressionCompiler(const std::string& text, Expression& expr) : p(text.c_str()), begin(text.c_str()), end(text.c_str() + text.size()), code(expr.code) {}
+
+    bool compile(std::string& error) {
+        code.clear();
+        depth = maxDepth = nesting = 0;
+        parseSum();
+        skipSpace();
+        if (message.empty() && p != end) fail("unexpected '" + std::string(1, *p) + "'");
+        if (message.empty() && maxDepth > EXPRESSION_MAX_DEPTH) message = "expression is too deeply nested";
+        error = message;
+        return message.empty();
+    }
+
+private:
+    typedef Expression E;
+
+    void skipSpace() {
+        while (p < end && std::isspace((unsigned char)*p)) p++;
+    }
+
+    bool accept(char c) {
+        skipSpace();
+        if (p < end && *p == c) {
+            p++;
+            return true;
+        }
+        return false;
+    }
+
+    void fail(const std::string& what) {
+        if (message.empty()) message = what + " at position " + std::to_string(p - begin + 1);
+        p = end;
+    }
+
+    void push() {
+        if (++depth > maxDepth) maxDepth = depth;
+    }
+
+    bool isConst(size_t at) const { return at + 1 == code.size() && code[at].op == E::Const; }
+
+    void emit(E::Op op, double value = 0, int n = 0) {
+        code.push_back({op, n, value});
+    }
+
+    void emitUnary(E::Op op, int n = 0) {
+        if (!message.empty()) return;
+        E::Instruction in = {op, n, 0};
+        if (code.back().op == E::Const) {
+            code.back().value = E::apply(in, code.back().value);
+        } else {
+            code.push_back(in);
+        }
+    }
+
+    // Emits a binary operation whose operands are code[left, right) and
+    // code[right, end).
+    void emitBinary(char op, size_t left, size_t right) {
+        depth--;
+        if (!message.empty()) return;
+        bool leftConst = right - left == 1 && code[left].op == E::Const;
+        bool rightConst = isConst(right);
+        if (leftConst && rightConst) {
+            double a = code[left].value, b = code[right].value;
+            code.pop_back();
+            code.back().value = op == '+' ? a + b : op == '-' ? a - b : op == '*' ? a * b : op == '/' ? a / b : std::pow(a, b);
+            return;
+        }
+        if (rightConst) {
+            double b = code.back().value;
+            code.pop_back();
+            switch (op) {
+            case '+': emit(E::AddC, b); break;
+            case '-': emit(E::SubC, b); break;
+            case '*': emit(E::MulC, b); break;
+            case '/': emit(E::DivC, b); break;
+            case '^': emitPower(b); break;
+            }
+            return;
+        }
+        if (leftConst && op != '^') {
+            double a = code[left].value;
+            code.erase(code.begin() + left);
+            switch (op) {
+            case '+': emit(E::AddC, a); break;
+            case '-': emit(E::ConstSub, a); break;
+            case '*': emit(E::MulC, a); break;
+            case '/': emit(E::ConstDiv, a); break;
+            }
+            return;
+        }
+        if (right + 1 == code.size() && code[right].op == E::X && op != '^') {
+            code.pop_back();
+            emit(op == '+' ? E::AddX : op == '-' ? E::SubX : op == '*' ? E::MulX : E::DivX);
+            return;
+        }
+        if (right - left == 1 && code[left].op == E::X && op != '^') {
+            code.erase(code.begin() + left);
+            emit(op == '+' ? E::AddX : op == '-' ? E::XSub : op == '*' ? E::MulX : E::XDiv);
+            return;
+        }
+        emit(op == '+' ? E::Add : op == '-' ? E::Sub : op == '*' ? E::Mul : op == '/' ? E::Div : E::Pow);
+    }
+
+    void emitPower(double e) {
+        if (e == 1) return;
+        if (e == 2) {
+            emit(E::Square);
+        } else if (e == 3) {
+            emit(E::Cube);
+        } else if (e == 0.5) {
+            emit(E::Sqrt);
+        } else if (e == std::floor(e) && std::abs(e) <= 64) {
+            emit(E::PowInt, 0, (int)e);
+        } else {
+            emit(E::PowC, e);
+        }
+    }
+
+    // sum := product (('+' | '-') product)*
+    void parseSum() {
+        size_t left = code.size();
+        parseProduct();
+        for (;;) {
+            char op = accept('+') ? '+' : accept('-') ? '-' : 0;
+            if (!op) return;
+            size_t right = code.size();
+            parseProduct();
+            emitBinary(op, left, right);
+        }
+    }
+
+    // product := unary (('*' | '/' | implicit) unary)*
+    void parseProduct() {
+        size_t left = code.size();
+        parseUnary();
+        for (;;) {
+            skipSpace();
+            char op = accept('*') ? '*' : accept('/') ? '/' : 0;
+            if (!op && p < end && (std::isalpha((unsigned char)*p) || *p == '(')) op = '*';
+            if (!op) return;
+            size_t right = code.size();
+            parseUnary();
+            emitBinary(op, left, right);
+        }
+    }
+
+    bool enter() {
+        if (++nesting <= EXPRESSION_MAX_NESTING) return true;
+        nesting--;
+        fail("expression is too deeply nested");
+        return false;
+    }
+
+    // unary := ('-' | '+') unary | power
+    void parseUnary() {
+        if (!enter()) return;
+        if (accept('-')) {
+            parseUnary();
+            emitUnary(E::Neg);
+        } else if (accept('+')) {
+            parseUnary();
+        } else {
+            parsePower();
+        }
+        nesting--;
+    }
+
+    // power := primary ('^' unary)?
+    void parsePower() {
+        size_t left = code.size();
+        parsePrimary();
+        if (accept('^')) {
+            size_t right = code.size();
+            parseUnary();
+            emitBinary('^', left, right);
+        }
+    }
+
+    void parsePrimary() {
+        skipSpace();
+        if (p == end) {
+            fail("unexpected end of expression");
+            return;
+        }
+        if (accept('(')) {
+            if (enter()) {
+                parseSum();
+                nesting--;
+            }
+            if (!accept(')')) fail("missing ')'");
+            return;
+        }
+        if (std::isdigit((unsigned char)*p) || *p == '.') {
+            double value;
+            std::from_chars_result r = std::from_chars(p, end, value);
+            if (r.ec != std::errc()) {
+                fail("bad number");
+                return;
+            }
+            p = r.ptr;
+            push();
+            emit(E::Const, value);
+            return;
+        }
+        if (!std::isalpha((unsigned char)*p)) {
+            fail("unexpected '" + std::string(1, *p) + "'");
+            return;
+        }
+
+        const char* start = p;
+        while (p < end && (std::isalnum((unsigned char)*p) || *p == '_')) p++;
+        std::string name(start, p);
+        if (name == "x" || name == "X") {
+            push();
+            emit(E::X);
+        } else if (name == "pi") {
+            push();
+            emit(E::Const, 3.14159265358979323846);
+        } else if (name == "e") {
+            push();
+            emit(E::Const, 2.71828182845904523536);
+        } else {
+            static const struct { const char* name; E::Op op; } functions[] = {
+                {"sin", E::Sin}, {"cos", E::Cos}, {"tan", E::Tan},
+                {"asin", E::Asin}, {"acos", E::Acos}, {"atan", E::Atan},
+                {"sinh", E::Sinh}, {"cosh", E::Cosh}, {"tanh", E::Tanh},
+                {"exp", E::Exp}, {"log", E::Log}, {"ln", E::Log},
+                {"log10", E::Log10}, {"log2", E::Log2}, {"sqrt", E::Sqrt},
+                {"cbrt", E::Cbrt}, {"abs", E::Abs}, {"floor", E::Floor}, {"ceil", E::Ceil},
+            };
+            for (const auto& fn : functions) {
+                if (name == fn.name) {
+                    if (!accept('(')) {
+                        fail("expected '(' after " + name);
+                        return;
+                    }
+                    parseSum();
+                    if (!accept(')')) {
+                        fail("missing ')'");
+                        return;
+                    }
+                    emitUnary(fn.op);
+                    return;
+                }
+            }
+            p = start;
+            fail("unknown name '" + name + "'");
+        }
+    }
+
+    const char* p;
+    const char* begin;
+    const char* end;
+    std::vector<Expression::Instruction>& code;
+    std::string message;
+    int depth = 0, maxDepth = 0, nesting = 0;
+};
+
+// Returns false and sets error (with the position) if text is not a valid
+// expression in x.
+inline bool compileExpression(const std::string& text, Expression& expr, std::string& error) {
+    return ExpressionCompiler(text, expr).compile(error);
+}
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "iteration-trace.h"
+#include "lu.h"
+#include "matrix.h"
+#include "solve-status.h"
+
+// Anderson mixing for vector fixed-point problems x = g(x). Plain iteration
+// only uses the latest g(x); Anderson keeps the last `depth` differences of
+// the residuals f = g(x) - x and of g(x), and takes the combination of
+// recent g values whose combined residual is smallest in the least-squares
+// sense:
+//
+//     gamma = argmin |f(n) - dF gamma|,   x(n+1) = g(x(n)) - dG gamma
+//
+// For linear g this is equivalent to GMRES, and for nonlinear g it typically
+// turns a slowly (or not) converging iteration into a fast one at the cost
+// of one evaluation per iteration plus a depth x depth solve. depth = 0 is
+// plain iteration; 3 to 10 is usual. With one unknown it is also the scalar
+// method (depth 1 is then the secant method on g(x) - x).
+
+struct FixedPointSolution {
+    std::vector<double> x;
+    double residual;  // max_i |g(x)_i - x_i| at the last evaluation
+    int iterations;
+    int evaluations;
+    SolveStatus status;
+};
+
+inline double maxNorm(const std::vector<double>& v) {
+    double m = 0;
+    for (double e : v) {
+        m = std::max(m, std::abs(e));
+    }
+    return m;
+}
+
+// g is called as g(x, gx) and writes g(x) into gx, which has x's size.
+// Converged when max_i |g(x)_i - x_i| < tol; the returned x is that last
+// g(x). Trace: residual, history columns used.
+template <class G, class Observer = NoTrace>
+FixedPointSolution andersonFixedPoint(G&& g, std::vector<double> x, int depth, double tol, int maxIter, Observer&& observer = Observer()) {
+    int n = (int)x.size();
+    depth = std::max(depth, 0);
+    std::vector<double> gx(n), f(n), xNext(n), gNext(n), fNext(n), rhs;
+    std::vector<std::vector<double>> dF(depth, std::vector<double>(n)), dG(depth, std::vector<double>(n));
+    int stored = 0, slot = 0;
+
+    g(x, gx);
+    int evaluations = 1;
+    for (int i = 0; i < n; i++) {
+        f[i] = gx[i] - x[i];
+    }
+    double residual = maxNorm(f);
+    if (residual < tol) return {gx, residual, 0, evaluations, SolveStatus::Converged};
+
+    for (int iter = 1; iter <= maxIter; iter++) {
+        xNext = gx;
+        if (stored > 0) {
+            // Normal equations of the least-squares problem, with a relative
+            // ridge term so nearly parallel history columns stay solvable.
+            Matrix normal(stored, stored);
+            rhs.assign(stored, 0.0);
+            double largest = 0;
+            for (int j = 0; j < stored; j++) {
+                for (int k = 0; k <= j; k++) {
+                    double dot = 0;
+                    for (int i = 0; i < n; i++) {
+                        dot += dF[j][i] * dF[k][i];
+                    }
+                    normal[j][k] = normal[k][j] = dot;
+                }
+                for (int i = 0; i < n; i++) {
+                    rhs[j] += dF[j][i] * f[i];
+                }
+                largest = std::max(largest, normal[j][j]);
+            }
+            for (int j = 0; j < stored; j++) {
+                normal[j][j] += 1e-12 * largest;
+            }
+
+            LUFactorization lu(normal);
+            std::vector<double> gamma;
+            if (!lu.singular()) gamma = lu.solve(rhs);
+            bool usable = !gamma.empty();
+            for (double v : gamma) {
+                usable = usable && std::isfinite(v);
+            }
+            if (usable) {
+                for (int j = 0; j < stored; j++) {
+                    for (int i = 0; i < n; i++) {
+                        xNext[i] -= gamma[j] * dG[j][i];
+                    }
+                }
+            } else {
+                stored = slot = 0;  // start the history afresh from a plain step
+            }
+        }
+
+        g(xNext, gNext);
+        evaluations++;
+        for (int i = 0; i < n; i++) {
+            fNext[i] = gNext[i] - xNext[i];
+        }
+        if (depth > 0) {
+            for (int i = 0; i < n; i++) {
+                dF[slot][i] = fNext[i] - f[i];
+                dG[slot][i] = gNext[i] - gx[i];
+            }
+            slot = (slot + 1) % depth;
+            stored = std::min(stored + 1, depth);
+        }
+        x.swap(xNext);
+        gx.swap(gNext);
+        f.swap(fNext);
+
+        residual = maxNorm(f);
+        observer(IterationRecord{iter, {residual, (double)stored}});
+        if (residual < tol) return {gx, residual, iter, evaluations, SolveStatus::Converged};
+    }
+    return {gx, residual, maxIter, evaluations, SolveStatus::MaxIterations};
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef FIXED_SOLVER_H
+#define FIXED_SOLVER_H
+
+#include <array>
+
+// Solvers for systems whose size is known at compile time (the 3x3 and 4x4
+// hot paths). Everything lives in std::array on the stack, the loops have
+// constant trip counts so the compiler unrolls them, and every function is
+// constexpr so a constant system can be solved at compile time.
+
+template <int N>
+using FixedMatrix = std::array<std::array<double, N>, N>;
+
+template <int N>
+using FixedVector = std::array<double, N>;
+
+template <int N>
+struct FixedSolution {
+    FixedVector<N> x;
+    bool singular;
+};
+
+constexpr double fixedAbs(double v) {
+    return v < 0 ? -v : v;
+}
+
+template <int N>
+constexpr FixedSolution<N> solveFixedGauss(FixedMatrix<N> a, FixedVector<N> b) {
+    FixedSolution<N> result{};
+
+    for (int k = 0; k < N; k++) {
+        int maxIndex = k;
+        double maxVal = fixedAbs(a[k][k]);
+        for (int i = k + 1; i < N; i++) {
+            if (fixedAbs(a[i][k]) > maxVal) {
+                maxVal = fixedAbs(a[i][k]);
+                maxIndex = i;
+            }
+        }
+
+        if (maxVal == 0) {
+            result.singular = true;
+            return result;
+        }
+
+        if (maxIndex != k) {
+            for (int j = k; j < N; j++) {
+                double t = a[k][j];
+                a[k][j] = a[maxIndex][j];
+                a[maxIndex][j] = t;
+            }
+            double t = b[k];
+            b[k] = b[maxIndex];
+            b[maxIndex] = t;
+        }
+
+        for (int i = k + 1; i < N; i++) {
+            double factor = a[i][k] / a[k][k];
+            for (int j = k + 1; j < N; j++) {
+                a[i][j] -= factor * a[k][j];
+            }
+            b[i] -= factor * b[k];
+        }
+    }
+
+    for (int i = N - 1; i >= 0; i--) {
+        double sum = b[i];
+        for (int j = i + 1; j < N; j++) {
+            sum -= a[i][j] * result.x[j];
+        }
+        result.x[i] = sum / a[i][i];
+    }
+    return result;
+}
+
+// Packed LU with partial pivoting, laid out like LUFactorization in lu.h:
+// unit-lower L below the diagonal, U on and above it, P[i] the original row
+// now at position i.
+template <int N>
+struct FixedLU {
+    FixedMatrix<N> lu;
+    std::array<int, N> P;
+    bool singular;
+    bool oddPermutation;
+
+    constexpr FixedVector<N> solve(const FixedVector<N>& b) const {
+        FixedVector<N> x{};
+        for (int i = 0; i < N; i++) {
+            double sum = b[P[i]];
+            for (int j = 0; j < i; j++) {
+                sum -= lu[i][j] * x[j];
+            }
+            x[i] = sum;
+        }
+        for (int i = N - 1; i >= 0; i--) {
+            double sum = x[i];
+            for (int j = i + 1; j < N; j++) {
+                sum -= lu[i][j] * x[j];
+            }
+            x[i] = sum / lu[i][i];
+        }
+        return x;
+    }
+
+    constexpr double determinant() const {
+        if (singular) return 0;
+        double det = oddPermutation ? -1 : 1;
+        for (int i = 0; i < N; i++) {
+            det *= lu[i][i];
+        }
+        return det;
+    }
+};
+
+template <int N>
+constexpr FixedLU<N> fixedLUFactor(const FixedMatrix<N>& a) {
+    FixedLU<N> f{a, {}, false, false};
+    for (int i = 0; i < N; i++) {
+        f.P[i] = i;
+    }
+
+    for (int k = 0; k < N; k++) {
+        int maxIndex = k;
+        double maxVal = fixedAbs(f.lu[k][k]);
+        for (int i = k + 1; i < N; i++) {
+            if (fixedAbs(f.lu[i][k]) > maxVal) {
+                maxVal = fixedAbs(f.lu[i][k]);
+                maxIndex = i;
+            }
+        }
+
+        if (maxVal == 0) {
+            f.singular = true;
+            return f;
+        }
+
+        if (maxIndex != k) {
+            for (int j = 0; j < N; j++) {
+                double t = f.lu[k][j];
+                f.lu[k][j] = f.lu[maxIndex][j];
+                f.lu[maxIndex][j] = t;
+            }
+            int t = f.P[k];
+            f.P[k] = f.P[maxIndex];
+            f.P[maxIndex] = t;
+            f.oddPermutation = !f.oddPermutation;
+        }
+
+        for (int i = k + 1; i < N; i++) {
+            double factor = f.lu[i][k] / f.lu[k][k];
+            f.lu[i][k] = factor;
+            for (int j = k + 1; j < N; j++) {
+                f.lu[i][j] -= factor * f.lu[k][j];
+            }
+        }
+    }
+    return f;
+}
+
+#endif
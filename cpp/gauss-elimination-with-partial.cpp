@@ -1,11 +1,15 @@
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
 #include <vector>
-#include <cmath>
 #include <iomanip>
+#include "matrix.h"
+#include "matrix-io.h"
+#include "linear-solvers.h"
 
 using namespace std;
 
-void inputMatrix(vector<vector<double>>& matrix, int n) {
+void inputMatrix(Matrix& matrix, int n) {
     cout << "Enter the coefficients of the augmented matrix (n x n+1):\n";
     for (int i = 0; i < n; i++) {
         for (int j = 0; j <= n; j++) {
@@ -15,7 +19,7 @@ void inputMatrix(vector<vector<double>>& matrix, int n) {
     }
 }
 
-void printMatrix(const vector<vector<double>>& matrix, int n) {
+void printMatrix(const Matrix& matrix, int n) {
     for (int i = 0; i < n; i++) {
         for (int j = 0; j <= n; j++) {
             cout << setw(10) << matrix[i][j] << " ";
@@ -31,55 +35,59 @@ void printSolution(const vector<double>& x, int n) {
     }
 }
 
-void gaussEliminationPartialPivot(vector<vector<double>> matrix, int n) {
-    vector<double> x(n);
-    
-    for (int k = 0; k < n - 1; k++) {
-        int maxIndex = k;
-        double maxVal = abs(matrix[k][k]);
-        for (int i = k + 1; i < n; i++) {
-            if (abs(matrix[i][k]) > maxVal) {
-                maxVal = abs(matrix[i][k]);
-                maxIndex = i;
-            }
-        }
-        
-        if (maxIndex != k) {
-            swap(matrix[k], matrix[maxIndex]);
-        }
-        
-        for (int i = k + 1; i < n; i++) {
-            double factor = matrix[i][k] / matrix[k][k];
-            for (int j = k; j <= n; j++) {
-                matrix[i][j] -= factor * matrix[k][j];
-            }
+// --threads N splits the row updates of large systems across N threads
+// (0: every hardware thread); the default is serial.
+int main(int argc, char* argv[]) {
+    const char* input = nullptr;
+    int threads = 1;
+    bool map = false, inPlace = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--mmap") == 0) {
+            map = true;
+        } else if (strcmp(argv[i], "--in-place") == 0) {
+            map = inPlace = true;
+        } else {
+            input = argv[i];
         }
     }
     
-    for (int i = n - 1; i >= 0; i--) {
-        double sum = matrix[i][n];
-        for (int j = i + 1; j < n; j++) {
-            sum -= matrix[i][j] * x[j];
-        }
-        x[i] = sum / matrix[i][i];
-    }
-    
-    printSolution(x, n);
-}
-
-int main() {
     int n;
-    cout << "Enter the number of equations (n): ";
-    cin >> n;
-    
-    vector<vector<double>> matrix(n, vector<double>(n + 1));
+    Matrix matrix;
+    MappedSystem mapped;
     
-    inputMatrix(matrix, n);
-    
-    cout << "\nAugmented Matrix:\n";
-    printMatrix(matrix, n);
+    string error;
+    if (inPlace && !input) {
+        cout << "Error: --in-place needs a binary system file.\n";
+        return 1;
+    }
+    if (input && map && mapped.open(input, inPlace, error)) {
+        n = mapped.size();
+    } else if (inPlace) {
+        // Solving a copy would leave the file unchanged without saying so.
+        cout << "Error: " << error << "\n";
+        return 1;
+    } else if (input) {
+        if (!readSystem(input, matrix, n, error)) {
+            cout << "Error: " << error << "\n";
+            return 1;
+        }
+    } else {
+        cout << "Enter the number of equations (n): ";
+        cin >> n;
+        matrix = Matrix(n, n + 1);
+        inputMatrix(matrix, n);
+        cout << "\nAugmented Matrix:\n";
+        printMatrix(matrix, n);
+    }
     
     cout << "\nGauss Elimination with Partial Pivoting:\n";
-    gaussEliminationPartialPivot(matrix, n);
+    LinearSolution result = gaussEliminationPartialPivot(mapped.size() ? mapped.matrix() : matrix, n, threads);
+    if (result.status == SolveStatus::Singular) {
+        cout << "Matrix is singular, no unique solution exists.\n";
+    } else {
+        printSolution(result.x, n);
+    }
     
 }
\ No newline at end of file
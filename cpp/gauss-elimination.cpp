@@ -1,9 +1,13 @@
 #include <iostream>
 #include <vector>
 #include <iomanip>
+#include "matrix.h"
+#include "matrix-io.h"
+#include "linear-solvers.h"
+
 using namespace std;
 
-void inputMatrix(vector<vector<double>>& matrix, int n) {
+void inputMatrix(Matrix& matrix, int n) {
     cout << "Enter the coefficients of the augmented matrix (n x n+1):\n";
     for (int i = 0; i < n; i++) {
         for (int j = 0; j <= n; j++) {
@@ -13,7 +17,7 @@ void inputMatrix(vector<vector<double>>& matrix, int n) {
     }
 }
 
-void printMatrix(const vector<vector<double>>& matrix, int n) {
+void printMatrix(const Matrix& matrix, int n) {
     for (int i = 0; i < n; i++) {
         for (int j = 0; j <= n; j++) {
             cout << setw(10) << matrix[i][j] << " ";
@@ -29,41 +33,30 @@ void printSolution(const vector<double>& x, int n) {
     }
 }
 
-void gaussElimination(vector<vector<double>> matrix, int n) {
-    vector<double> x(n);
-
-    for (int k = 0; k < n - 1; k++) {
-        for (int i = k + 1; i < n; i++) {
-            double factor = matrix[i][k] / matrix[k][k];
-            for (int j = k; j <= n; j++) {
-                matrix[i][j] -= factor * matrix[k][j];
-            }
-        }
-    }
+int main(int argc, char* argv[]) {
+    int n;
+    Matrix matrix;
 
-    for (int i = n - 1; i >= 0; i--) {
-        double sum = matrix[i][n];
-        for (int j = i + 1; j < n; j++) {
-            sum -= matrix[i][j] * x[j];
+    if (argc > 1) {
+        string error;
+        if (!readSystem(argv[1], matrix, n, error)) {
+            cout << "Error: " << error << "\n";
+            return 1;
         }
-        x[i] = sum / matrix[i][i];
+    } else {
+        cout << "Enter the number of equations (n): ";
+        cin >> n;
+        matrix = Matrix(n, n + 1);
+        inputMatrix(matrix, n);
+        cout << "Augmented Matrix:\n";
+        printMatrix(matrix, n);
     }
 
-    printSolution(x, n);
-}
-
-int main() {
-    int n;
-    cout << "Enter the number of equations (n): ";
-    cin >> n;
-
-    vector<vector<double>> matrix(n, vector<double>(n + 1));
-
-    inputMatrix(matrix, n);
-
-    cout << "Augmented Matrix:\n";
-    printMatrix(matrix, n);
-
     cout << "Gauss Elimination:\n";
-    gaussElimination(matrix, n);
+    LinearSolution result = gaussElimination(matrix, n);
+    if (result.status == SolveStatus::Singular) {
+        cout << "Matrix is singular, no unique solution exists.\n";
+    } else {
+        printSolution(result.x, n);
+    }
 }
\ No newline at end of file
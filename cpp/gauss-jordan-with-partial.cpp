@@ -1,10 +1,15 @@
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
 #include <vector>
-#include <cmath>
 #include <iomanip>
+#include "matrix.h"
+#include "matrix-io.h"
+#include "linear-solvers.h"
+
 using namespace std;
 
-void inputMatrix(vector<vector<double>>& matrix, int n) {
+void inputMatrix(Matrix& matrix, int n) {
     cout << "Enter the coefficients of the augmented matrix (n x n+1):\n";
     for (int i = 0; i < n; i++) {
         for (int j = 0; j <= n; j++) {
@@ -14,7 +19,7 @@ void inputMatrix(vector<vector<double>>& matrix, int n) {
     }
 }
 
-void printMatrix(const vector<vector<double>>& matrix, int n) {
+void printMatrix(const Matrix& matrix, int n) {
     for (int i = 0; i < n; i++) {
         for (int j = 0; j <= n; j++) {
             cout << setw(10) << matrix[i][j] << " ";
@@ -30,55 +35,42 @@ void printSolution(const vector<double>& x, int n) {
     }
 }
 
-void gaussJordanPartialPivot(vector<vector<double>> matrix, int n) {
-    vector<double> x(n);
-    
-    for (int k = 0; k < n; k++) {
-        int maxIndex = k;
-        double maxVal = abs(matrix[k][k]);
-        for (int i = k + 1; i < n; i++) {
-            if (abs(matrix[i][k]) > maxVal) {
-                maxVal = abs(matrix[i][k]);
-                maxIndex = i;
-            }
-        }
-        
-        if (maxIndex != k) {
-            swap(matrix[k], matrix[maxIndex]);
-        }
-        
-        double pivot = matrix[k][k];
-        for (int j = k; j <= n; j++) {
-            matrix[k][j] /= pivot;
+// --threads N splits the row updates of large systems across N threads
+// (0: every hardware thread); the default is serial.
+int main(int argc, char* argv[]) {
+    const char* input = nullptr;
+    int threads = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else {
+            input = argv[i];
         }
-        for (int i = 0; i < n; i++) {
-            if (i != k) {
-                double factor = matrix[i][k];
-                for (int j = k; j <= n; j++) {
-                    matrix[i][j] -= factor * matrix[k][j];
-                }
-            }
-        }
-    }
-    
-    for (int i = 0; i < n; i++) {
-        x[i] = matrix[i][n];
     }
     
-    printSolution(x, n);
-}
-
-int main() {
     int n;
-    cout << "Enter the number of equations (n): ";
-    cin >> n;
-    
-    vector<vector<double>> matrix(n, vector<double>(n + 1));
+    Matrix matrix;
     
-    inputMatrix(matrix, n);
-    cout << "\nAugmented Matrix:\n";
-    printMatrix(matrix, n);
+    if (input) {
+        string error;
+        if (!readSystem(input, matrix, n, error)) {
+            cout << "Error: " << error << "\n";
+            return 1;
+        }
+    } else {
+        cout << "Enter the number of equations (n): ";
+        cin >> n;
+        matrix = Matrix(n, n + 1);
+        inputMatrix(matrix, n);
+        cout << "\nAugmented Matrix:\n";
+        printMatrix(matrix, n);
+    }
     cout << "Gauss-Jordan with Partial Pivoting:\n";
-    gaussJordanPartialPivot(matrix, n);
+    LinearSolution result = gaussJordanPartialPivot(matrix, n, threads);
+    if (result.status == SolveStatus::Singular) {
+        cout << "Matrix is singular, no unique solution exists.\n";
+    } else {
+        printSolution(result.x, n);
+    }
     
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
+#include "expression-jit.h"
+#include "root-finding.h"
 
 using namespace std;
 
@@ -8,62 +11,66 @@ double f(double x) {
     return x * x - 4 * x + 4;
 }
 
-void goldenSectionSearch(double a, double b, double tol, int maxIter) {
-    const double phi = (1 + sqrt(5)) / 2; // Golden ratio ≈ 1.618
-    cout << "\nGolden Section Search for minimization:\n";
+void printHeader(const char* method, double a, double b, double tol, int maxIter) {
+    cout << "\n" << method << " for minimization:\n";
     cout << "Initial interval: [" << a << ", " << b << "]\n";
-    cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n\n";
-    cout << setw(5) << "Iter" << setw(12) << "a" << setw(12) << "b" 
-         << setw(12) << "x1" << setw(12) << "x2" 
-         << setw(12) << "f(x1)" << setw(12) << "f(x2)" << endl;
-    cout << string(75, '-') << endl;
-
-    double x1, x2, f1, f2;
-    int iter = 0;
-
-    while (iter < maxIter && (b - a) > tol) {
-        
-        double d = (b - a) / phi;
-        x1 = b - d; 
-        x2 = a + d; 
-        f1 = f(x1);
-        f2 = f(x2);
+    cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n";
+}
 
-        
-        cout << setw(5) << iter + 1 
-             << setw(12) << fixed << setprecision(6) << a 
-             << setw(12) << b 
-             << setw(12) << x1 
-             << setw(12) << x2 
-             << setw(12) << f1 
-             << setw(12) << f2 << endl;
+// Brent's trace has the best point x and the new point u where golden
+// section has x1 and x2.
+void printIterations(const IterationTrace& trace, bool brent) {
+    cout << "\n" << setw(5) << "Iter" << setw(12) << "a" << setw(12) << "b"
+         << setw(12) << (brent ? "x" : "x1") << setw(12) << (brent ? "u" : "x2")
+         << setw(12) << (brent ? "f(x)" : "f(x1)") << setw(12) << (brent ? "f(u)" : "f(x2)") << endl;
+    cout << string(75, '-') << endl;
+    if (trace.total() > (unsigned long long)trace.size()) {
+        cout << "(" << trace.total() - trace.size() << " earlier iterations not kept)\n";
+    }
+    for (int i = 0; i < trace.size(); i++) {
+        const IterationRecord& r = trace[i];
+        cout << setw(5) << r.iteration << fixed << setprecision(6);
+        for (int k = 0; k < 6; k++) {
+            cout << setw(12) << r.values[k];
+        }
+        cout << "\n";
+    }
+}
 
-        
-        if (f1 < f2) {
-            
-            b = x2;
+// An argument other than --brent replaces the built-in f, e.g.
+// "x^3 - 2*x - 5". --brent selects Brent's parabolic-interpolation
+// minimizer, which usually needs far fewer evaluations on smooth f.
+int main(int argc, char* argv[]) {
+    const char* text = nullptr;
+    const char* method = "Golden Section Search";
+    bool brent = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--brent") == 0) {
+            brent = true;
+            method = "Brent's Method";
         } else {
-            
-            a = x1;
+            text = argv[i];
         }
-
-        iter++;
     }
 
-    double x_opt = (a + b) / 2;
-    double f_opt = f(x_opt);
-
-    cout << "\nAfter " << iter << " iterations:\n";
-    cout << "Approximate minimum at x = " << x_opt << "\n";
-    cout << "Function value at minimum: f(x) = " << f_opt << "\n";
-}
+    Expression expr;
+    if (text) {
+        string error;
+        if (!compileExpression(text, expr, error)) {
+            cout << "Error: " << error << "\n";
+            return 1;
+        }
+    }
 
-int main() {
     double a, b, tol;
     int maxIter;
 
-    cout << "Golden Section Search for Unimodal Function Minimization\n";
-    cout << "Function: f(x) = x^2 - 4x + 4 (modify the f(x) function as needed)\n\n";
+    cout << method << " for Unimodal Function Minimization\n";
+    if (text) {
+        cout << "Function: f(x) = " << text << "\n\n";
+    } else {
+        cout << "Function: f(x) = x^2 - 4x + 4 (or pass f(x) as the first argument)\n\n";
+    }
 
     cout << "Enter the interval [a, b]:\n";
     cout << "a: ";
@@ -89,6 +96,20 @@ int main() {
         return 1;
     }
 
-    goldenSectionSearch(a, b, tol, maxIter);
+    printHeader(method, a, b, tol, maxIter);
+    JitExpression jit(expr);
+    FunctionRef fn = text ? FunctionRef(jit) : FunctionRef(f);
+    IterationTrace trace;
+    MinimumResult result = brent ? brentMinimize(fn, a, b, tol, maxIter, trace) : goldenSectionSearch(fn, a, b, tol, maxIter, trace);
+    printIterations(trace, brent);
+
+    cout << "\nAfter " << result.iterations << " iterations:\n";
+    cout << fixed << setprecision(6);
+    cout << "Approximate minimum at x = " << result.x << "\n";
+    cout << "Function value at minimum: f(x) = " << result.value << "\n";
+    cout << "Function evaluations: " << result.evaluations << "\n";
+    if (result.status == SolveStatus::MaxIterations) {
+        cout << "Warning: " << statusMessage(result.status) << ".\n";
+    }
 
 }
\ No newline at end of file
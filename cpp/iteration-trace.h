@@ -0,0 +1,53 @@
+#ifndef ITERATION_TRACE_H
+#define ITERATION_TRACE_H
+
+#include <vector>
+
+// Per-iteration tracing for the iterative solvers. A solver calls
+// observer(record) once per iteration; with the default NoTrace the call is
+// empty and inlined away, so untraced solves pay nothing. IterationTrace keeps
+// the most recent records in a fixed ring buffer for debugging, and nothing
+// is formatted until someone reads it.
+
+// One iteration's numbers. Which quantity sits in which slot is documented
+// with each solver; unused slots are left 0.
+struct IterationRecord {
+    int iteration;
+    double values[6];
+};
+
+struct NoTrace {
+    void operator()(const IterationRecord&) const {}
+};
+
+class IterationTrace {
+public:
+    // Keeps the last `capacity` records (rounded up to a power of two).
+    explicit IterationTrace(int capacity = 1024) {
+        int size = 1;
+        while (size < capacity) size <<= 1;
+        records.resize(size);
+    }
+
+    void operator()(const IterationRecord& record) {
+        records[count++ & (records.size() - 1)] = record;
+    }
+
+    // Records currently held and how many were ever written; the difference
+    // is how many old ones were overwritten.
+    int size() const { return count < records.size() ? (int)count : (int)records.size(); }
+    unsigned long long total() const { return count; }
+
+    // i = 0 is the oldest record still held.
+    const IterationRecord& operator[](int i) const {
+        return records[(count - size() + i) & (records.size() - 1)];
+    }
+
+    void clear() { count = 0; }
+
+private:
+    std::vector<IterationRecord> records;
+    unsigned long long count = 0;
+};
+
+#endif
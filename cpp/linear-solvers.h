@@ -0,0 +1,236 @@
+#ifndef LINEAR_SOLVERS_H
+#define LINEAR_SOLVERS_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "lu.h"
+#include "matrix.h"
+#include "row-kernels.h"
+#include "solve-status.h"
+#include "thread-pool.h"
+
+// Direct solvers for the augmented n x (n + 1) system [A | b] in `matrix`.
+// Each one works in place on the view it is given (pass a copy, or
+// Matrix::assign into a reused workspace, to keep the original) and returns
+// the solution with a status; x is empty when the status is Singular. A zero
+// pivot counts as singular, so the unpivoted solvers also report systems they
+// merely cannot handle without row exchanges.
+
+struct LinearSolution {
+    std::vector<double> x;
+    SolveStatus status;
+};
+
+inline LinearSolution singularSolution() {
+    return {std::vector<double>(), SolveStatus::Singular};
+}
+
+// Back substitution on an upper-triangular augmented matrix.
+inline std::vector<double> backSubstitute(MatrixView matrix, int n) {
+    std::vector<double> x(n);
+    for (int i = n - 1; i >= 0; i--) {
+        double sum = matrix[i][n];
+        for (int j = i + 1; j < n; j++) {
+            sum -= matrix[i][j] * x[j];
+        }
+        x[i] = sum / matrix[i][i];
+    }
+    return x;
+}
+
+// Moves the row with the largest |matrix[i][k]|, i >= k, into row k and
+// returns that magnitude.
+inline double partialPivot(MatrixView matrix, int n, int k) {
+    int maxIndex = k;
+    double maxVal = std::abs(matrix[k][k]);
+    for (int i = k + 1; i < n; i++) {
+        if (std::abs(matrix[i][k]) > maxVal) {
+            maxVal = std::abs(matrix[i][k]);
+            maxIndex = i;
+        }
+    }
+    matrix.swapRows(k, maxIndex);
+    return maxVal;
+}
+
+inline LinearSolution gaussElimination(MatrixView matrix, int n) {
+    std::vector<double*> rows(n);
+    std::vector<double> factors(n);
+
+    for (int k = 0; k < n; k++) {
+        const double* rowK = matrix[k];
+        if (rowK[k] == 0) return singularSolution();
+        int count = 0;
+        for (int i = k + 1; i < n; i++) {
+            rows[count] = matrix[i] + k;
+            factors[count++] = matrix[i][k] / rowK[k];
+        }
+        rowAxpyMany(rows.data(), factors.data(), count, rowK + k, n + 1 - k);
+    }
+
+    return {backSubstitute(matrix, n), SolveStatus::Converged};
+}
+
+// Each pivot's row updates are split across `threads` threads (<= 0: every
+// hardware thread). The default is serial, and systems too small to split
+// never start a pool.
+inline LinearSolution gaussEliminationPartialPivot(MatrixView matrix, int n, int threads = 1) {
+    ThreadPool pool(poolThreads(threads, (long long)n * (n + 1)));
+    std::vector<double*> rows(n);
+    std::vector<double> factors(n);
+
+    for (int k = 0; k < n; k++) {
+        if (partialPivot(matrix, n, k) == 0) return singularSolution();
+
+        const double* rowK = matrix[k];
+        int count = 0;
+        for (int i = k + 1; i < n; i++) {
+            rows[count] = matrix[i] + k;
+            factors[count++] = matrix[i][k] / rowK[k];
+        }
+        int width = n + 1 - k;
+        pool.parallelFor(0, count, PARALLEL_MIN_WORK / width, [&](int lo, int hi) {
+            rowAxpyMany(rows.data() + lo, factors.data() + lo, hi - lo, rowK + k, width);
+        });
+    }
+
+    return {backSubstitute(matrix, n), SolveStatus::Converged};
+}
+
+// Reduces the coefficient block to the identity; x is then the last column.
+inline LinearSolution gaussJordan(MatrixView matrix, int n) {
+    std::vector<double*> rows(n);
+    std::vector<double> factors(n);
+
+    for (int k = 0; k < n; k++) {
+        double* rowK = matrix[k];
+        double pivot = rowK[k];
+        if (pivot == 0) return singularSolution();
+        for (int j = k; j <= n; j++) {
+            rowK[j] /= pivot;
+        }
+        int count = 0;
+        for (int i = 0; i < n; i++) {
+            if (i != k) {
+                rows[count] = matrix[i] + k;
+                factors[count++] = matrix[i][k];
+            }
+        }
+        rowAxpyMany(rows.data(), factors.data(), count, rowK + k, n + 1 - k);
+    }
+
+    std::vector<double> x(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = matrix[i][n];
+    }
+    return {x, SolveStatus::Converged};
+}
+
+inline LinearSolution gaussJordanPartialPivot(MatrixView matrix, int n, int threads = 1) {
+    ThreadPool pool(poolThreads(threads, (long long)n * (n + 1)));
+    std::vector<double*> rows(n);
+    std::vector<double> factors(n);
+
+    for (int k = 0; k < n; k++) {
+        if (partialPivot(matrix, n, k) == 0) return singularSolution();
+
+        double* rowK = matrix[k];
+        double pivot = rowK[k];
+        for (int j = k; j <= n; j++) {
+            rowK[j] /= pivot;
+        }
+        int count = 0;
+        for (int i = 0; i < n; i++) {
+            if (i != k) {
+                rows[count] = matrix[i] + k;
+                factors[count++] = matrix[i][k];
+            }
+        }
+        int width = n + 1 - k;
+        pool.parallelFor(0, count, PARALLEL_MIN_WORK / width, [&](int lo, int hi) {
+            rowAxpyMany(rows.data() + lo, factors.data() + lo, hi - lo, rowK + k, width);
+        });
+    }
+
+    std::vector<double> x(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = matrix[i][n];
+    }
+    return {x, SolveStatus::Converged};
+}
+
+// Doolittle LU stored in place: the strict lower part of the coefficient
+// block holds L (unit diagonal implied) and the upper part holds U.
+inline LinearSolution luDecomposition(MatrixView matrix, int n) {
+    std::vector<double*> rows(n);
+    std::vector<double> factors(n);
+
+    for (int k = 0; k < n; k++) {
+        const double* rowK = matrix[k];
+        if (rowK[k] == 0) return singularSolution();
+        int count = 0;
+        for (int i = k + 1; i < n; i++) {
+            double* rowI = matrix[i];
+            rowI[k] /= rowK[k];
+            rows[count] = rowI + k + 1;
+            factors[count++] = rowI[k];
+        }
+        rowAxpyMany(rows.data(), factors.data(), count, rowK + k + 1, n - k - 1);
+    }
+
+    std::vector<double> x(n);
+    for (int i = 0; i < n; i++) {
+        const double* rowI = matrix[i];
+        double sum = rowI[n];
+        for (int j = 0; j < i; j++) {
+            sum -= rowI[j] * x[j];
+        }
+        x[i] = sum;
+    }
+
+    for (int i = n - 1; i >= 0; i--) {
+        const double* rowI = matrix[i];
+        double sum = x[i];
+        for (int j = i + 1; j < n; j++) {
+            sum -= rowI[j] * x[j];
+        }
+        x[i] = sum / rowI[i];
+    }
+    return {x, SolveStatus::Converged};
+}
+
+// Blocked, pivoted LU of the coefficient block (see lu.h); only the pivot
+// vector and the solution are allocated on top of the matrix.
+inline LinearSolution luDecompositionPartialPivot(MatrixView matrix, int n) {
+    LUFactorization lu(matrix.block(0, 0, n, n));
+    if (lu.singular()) return singularSolution();
+
+    std::vector<double> b(n);
+    for (int i = 0; i < n; i++) {
+        b[i] = matrix[i][n];
+    }
+    return {lu.solve(b), SolveStatus::Converged};
+}
+
+// x_j = det(A_j) / det(A) for every j is exactly A^-1 b, so one pivoted LU
+// gives both the determinant check and the solution in O(n^3).
+inline LinearSolution cramersRule(MatrixView matrix, int n) {
+    return luDecompositionPartialPivot(matrix, n);
+}
+
+// max_i |A x - b|_i for an unmodified augmented system.
+inline double residualNorm(MatrixView system, const std::vector<double>& x) {
+    int n = system.rows();
+    double worst = 0;
+    for (int i = 0; i < n; i++) {
+        double r = -system[i][n];
+        for (int j = 0; j < n; j++) {
+            r += system[i][j] * x[j];
+        }
+        worst = std::max(worst, std::abs(r));
+    }
+    return worst;
+}
+
+#endif
@@ -1,10 +1,14 @@
 #include <iostream>
+#include <cstring>
 #include <vector>
-#include <cmath>
 #include <iomanip>
+#include "matrix.h"
+#include "matrix-io.h"
+#include "linear-solvers.h"
+
 using namespace std;
 
-void inputMatrix(vector<vector<double>>& matrix, int n) {
+void inputMatrix(Matrix& matrix, int n) {
     cout << "Enter the coefficients of the augmented matrix (n x n+1):\n";
     for (int i = 0; i < n; i++) {
         for (int j = 0; j <= n; j++) {
@@ -14,7 +18,7 @@ void inputMatrix(vector<vector<double>>& matrix, int n) {
     }
 }
 
-void printMatrix(const vector<vector<double>>& matrix, int n) {
+void printMatrix(const Matrix& matrix, int n) {
     for (int i = 0; i < n; i++) {
         for (int j = 0; j <= n; j++) {
             cout << setw(10) << matrix[i][j] << " ";
@@ -30,89 +34,53 @@ void printSolution(const vector<double>& x, int n) {
     }
 }
 
-void luDecompositionPartialPivot(vector<vector<double>> matrix, int n) {
-    vector<vector<double>> L(n, vector<double>(n, 0));
-    vector<vector<double>> U(n, vector<double>(n, 0));
-    vector<double> b(n);
-    vector<int> P(n);
-    vector<double> x(n), y(n);
-    
-    for (int i = 0; i < n; i++) {
-        P[i] = i;
-        L[i][i] = 1;
-        b[i] = matrix[i][n];
-    }
-    
-    for (int k = 0; k < n; k++) {
-        int maxIndex = k;
-        double maxVal = abs(matrix[k][k]);
-        for (int i = k + 1; i < n; i++) {
-            if (abs(matrix[i][k]) > maxVal) {
-                maxVal = abs(matrix[i][k]);
-                maxIndex = i;
-            }
-        }
-        
-        if (maxVal == 0) {
-            cout << "Matrix is singular, no unique solution exists.\n";
-            return;
-        }
-        
-        if (maxIndex != k) {
-            swap(matrix[k], matrix[maxIndex]);
-            swap(P[k], P[maxIndex]);
-            for (int j = 0; j < k; j++) {
-                swap(L[k][j], L[maxIndex][j]);
-            }
-        }
-        
-        for (int j = k; j < n; j++) {
-            U[k][j] = matrix[k][j];
-        }
-        
-        for (int i = k + 1; i < n; i++) {
-            L[i][k] = matrix[i][k] / U[k][k];
-            for (int j = k; j < n; j++) {
-                matrix[i][j] -= L[i][k] * U[k][j];
-            }
+int main(int argc, char* argv[]) {
+    const char* input = nullptr;
+    bool map = false, inPlace = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--mmap") == 0) {
+            map = true;
+        } else if (strcmp(argv[i], "--in-place") == 0) {
+            map = inPlace = true;
+        } else {
+            input = argv[i];
         }
     }
     
-    vector<double> Pb(n);
-    for (int i = 0; i < n; i++) {
-        Pb[i] = b[P[i]];
-    }
+    int n;
+    Matrix matrix;
+    MappedSystem mapped;
     
-    for (int i = 0; i < n; i++) {
-        double sum = Pb[i];
-        for (int j = 0; j < i; j++) {
-            sum -= L[i][j] * y[j];
-        }
-        y[i] = sum;
+    string error;
+    if (inPlace && !input) {
+        cout << "Error: --in-place needs a binary system file.\n";
+        return 1;
     }
-    
-    for (int i = n - 1; i >= 0; i--) {
-        double sum = y[i];
-        for (int j = i + 1; j < n; j++) {
-            sum -= U[i][j] * x[j];
+    if (input && map && mapped.open(input, inPlace, error)) {
+        n = mapped.size();
+    } else if (inPlace) {
+        // Solving a copy would leave the file unchanged without saying so.
+        cout << "Error: " << error << "\n";
+        return 1;
+    } else if (input) {
+        if (!readSystem(input, matrix, n, error)) {
+            cout << "Error: " << error << "\n";
+            return 1;
         }
-        x[i] = sum / U[i][i];
+    } else {
+        cout << "Enter the number of equations (n): ";
+        cin >> n;
+        matrix = Matrix(n, n + 1);
+        inputMatrix(matrix, n);
+        cout << "Augmented Matrix:\n";
+        printMatrix(matrix, n);
     }
-    
-    printSolution(x, n);
-}
-
-int main() {
-    int n;
-    cout << "Enter the number of equations (n): ";
-    cin >> n;
-    
-    vector<vector<double>> matrix(n, vector<double>(n + 1));
-    
-    inputMatrix(matrix, n);
-    cout << "Augmented Matrix:\n";
-    printMatrix(matrix, n);
     cout << "LU Decomposition with Partial Pivoting:\n";
-    luDecompositionPartialPivot(matrix, n);
+    LinearSolution result = luDecompositionPartialPivot(mapped.size() ? mapped.matrix() : matrix, n);
+    if (result.status == SolveStatus::Singular) {
+        cout << "Matrix is singular, no unique solution exists.\n";
+    } else {
+        printSolution(result.x, n);
+    }
     
 }
\ No newline at end of file
@@ -0,0 +1,251 @@
+#ifndef LU_H
+#define LU_H
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "matrix.h"
+#include "row-kernels.h"
+
+const int LU_BLOCK_SIZE = 64;
+const int LU_TILE_COLS = 256;
+
+// c -= a * b, one column tile of b at a time so it stays in cache while four
+// of its rows are applied per pass over a row of c.
+inline void gemmSubtract(MatrixView c, MatrixView a, MatrixView b) {
+    int m = c.rows(), n = c.cols(), depth = a.cols();
+    for (int j0 = 0; j0 < n; j0 += LU_TILE_COLS) {
+        int width = std::min(LU_TILE_COLS, n - j0);
+        for (int i = 0; i < m; i++) {
+            double* rowC = c[i] + j0;
+            const double* rowA = a[i];
+            int p = 0;
+            for (; p + 4 <= depth; p += 4) {
+                const double* sources[4] = {b[p] + j0, b[p + 1] + j0, b[p + 2] + j0, b[p + 3] + j0};
+                rowAxpySources4(rowC, sources, rowA + p, width);
+            }
+            for (; p < depth; p++) {
+                rowAxpy(rowC, b[p] + j0, rowA[p], width);
+            }
+        }
+    }
+}
+
+// Unblocked LU of the panel a[k0.., k0..k1). Rows are swapped across the
+// whole view so the columns outside the panel stay consistent.
+inline bool luFactorPanel(MatrixView a, std::vector<int>& P, int k0, int k1) {
+    int n = a.rows();
+    std::vector<double*> rows(n);
+    std::vector<double> factors(n);
+    for (int k = k0; k < k1; k++) {
+        int maxIndex = k;
+        double maxVal = std::abs(a[k][k]);
+        for (int i = k + 1; i < n; i++) {
+            if (std::abs(a[i][k]) > maxVal) {
+                maxVal = std::abs(a[i][k]);
+                maxIndex = i;
+            }
+        }
+
+        if (maxVal == 0) return false;
+
+        if (maxIndex != k) {
+            a.swapRows(k, maxIndex);
+            std::swap(P[k], P[maxIndex]);
+        }
+
+        const double* rowK = a[k];
+        int count = 0;
+        for (int i = k + 1; i < n; i++) {
+            double* rowI = a[i];
+            rowI[k] /= rowK[k];
+            rows[count] = rowI + k + 1;
+            factors[count++] = rowI[k];
+        }
+        rowAxpyMany(rows.data(), factors.data(), count, rowK + k + 1, k1 - k - 1);
+    }
+    return true;
+}
+
+// Right-looking blocked LU with partial pivoting, in place on the square view
+// a. On return the strict lower part holds L (unit diagonal implied), the
+// upper part holds U, and P[i] is the original row now at position i.
+inline bool luFactorBlocked(MatrixView a, std::vector<int>& P, int blockSize = LU_BLOCK_SIZE) {
+    int n = a.rows();
+    std::vector<double*> rows(blockSize);
+    std::vector<double> factors(blockSize);
+    for (int i = 0; i < n; i++) {
+        P[i] = i;
+    }
+
+    for (int k0 = 0; k0 < n; k0 += blockSize) {
+        int k1 = std::min(k0 + blockSize, n);
+        if (!luFactorPanel(a, P, k0, k1)) return false;
+        if (k1 == n) break;
+
+        // U12 = L11^-1 * A12
+        for (int p = k0; p < k1; p++) {
+            int count = 0;
+            for (int i = p + 1; i < k1; i++) {
+                rows[count] = a[i] + k1;
+                factors[count++] = a[i][p];
+            }
+            rowAxpyMany(rows.data(), factors.data(), count, a[p] + k1, n - k1);
+        }
+
+        gemmSubtract(a.block(k1, k1, n - k1, n - k1), a.block(k1, k0, n - k1, k1 - k0), a.block(k0, k1, k1 - k0, n - k1));
+    }
+    return true;
+}
+
+// Packed LU factorization that is computed once and reused for any number of
+// right-hand sides. Built from a view it factors the caller's storage in place
+// (which must outlive it); built from a Matrix&& it owns the factors.
+class LUFactorization {
+public:
+    explicit LUFactorization(MatrixView a, int blockSize = LU_BLOCK_SIZE) : lu(a), P(a.rows()) {
+        ok = luFactorBlocked(lu, P, blockSize);
+    }
+
+    explicit LUFactorization(Matrix&& a, int blockSize = LU_BLOCK_SIZE) : storage(std::move(a)), lu(storage), P(storage.rows()) {
+        ok = luFactorBlocked(lu, P, blockSize);
+    }
+
+    LUFactorization(const LUFactorization&) = delete;
+    LUFactorization& operator=(const LUFactorization&) = delete;
+    LUFactorization(LUFactorization&&) = default;
+    LUFactorization& operator=(LUFactorization&&) = default;
+
+    int size() const { return lu.rows(); }
+    bool singular() const { return !ok; }
+    MatrixView factors() const { return lu; }
+    const std::vector<int>& pivots() const { return P; }
+
+    // log|det A|, accumulated term by term so large or tiny diagonals don't
+    // overflow; sign receives -1, 0 or 1.
+    double logAbsDeterminant(int& sign) const {
+        if (!ok) {
+            sign = 0;
+            return -HUGE_VAL;
+        }
+        sign = permutationSign();
+        double logDet = 0;
+        for (int i = 0; i < size(); i++) {
+            double u = lu[i][i];
+            if (u < 0) sign = -sign;
+            logDet += std::log(std::abs(u));
+        }
+        return logDet;
+    }
+
+    double determinant() const {
+        int sign;
+        double logDet = logAbsDeterminant(sign);
+        return sign == 0 ? 0.0 : sign * std::exp(logDet);
+    }
+
+    std::vector<double> solve(const std::vector<double>& b) const {
+        int n = size();
+        std::vector<double> x(n);
+        for (int i = 0; i < n; i++) {
+            x[i] = b[P[i]];
+        }
+
+        for (int i = 0; i < n; i++) {
+            const double* rowI = lu[i];
+            double sum = x[i];
+            for (int j = 0; j < i; j++) {
+                sum -= rowI[j] * x[j];
+            }
+            x[i] = sum;
+        }
+
+        for (int i = n - 1; i >= 0; i--) {
+            const double* rowI = lu[i];
+            double sum = x[i];
+            for (int j = i + 1; j < n; j++) {
+                sum -= rowI[j] * x[j];
+            }
+            x[i] = sum / rowI[i];
+        }
+        return x;
+    }
+
+    // Solves A X = B for every column of the n x m block B.
+    Matrix solve(MatrixView B, int blockSize = LU_BLOCK_SIZE) const {
+        int n = size(), m = B.cols();
+        Matrix X(n, m);
+        for (int i = 0; i < n; i++) {
+            std::copy(B[P[i]], B[P[i]] + m, X[i]);
+        }
+
+        for (int k0 = 0; k0 < n; k0 += blockSize) {
+            int k1 = std::min(k0 + blockSize, n);
+            for (int i = k0 + 1; i < k1; i++) {
+                gemmSubtract(X.block(i, 0, 1, m), lu.block(i, k0, 1, i - k0), X.block(k0, 0, i - k0, m));
+            }
+            if (k1 < n) {
+                gemmSubtract(X.block(k1, 0, n - k1, m), lu.block(k1, k0, n - k1, k1 - k0), X.block(k0, 0, k1 - k0, m));
+            }
+        }
+
+        for (int k1 = n; k1 > 0; k1 -= blockSize) {
+            int k0 = std::max(k1 - blockSize, 0);
+            for (int i = k1 - 1; i >= k0; i--) {
+                gemmSubtract(X.block(i, 0, 1, m), lu.block(i, i + 1, 1, k1 - i - 1), X.block(i + 1, 0, k1 - i - 1, m));
+                double* rowX = X[i];
+                double pivot = lu[i][i];
+                for (int j = 0; j < m; j++) {
+                    rowX[j] /= pivot;
+                }
+            }
+            if (k0 > 0) {
+                gemmSubtract(X.block(0, 0, k0, m), lu.block(0, k0, k0, k1 - k0), X.block(k0, 0, k1 - k0, m));
+            }
+        }
+        return X;
+    }
+
+private:
+    int permutationSign() const {
+        int n = size(), sign = 1;
+        std::vector<bool> seen(n, false);
+        for (int i = 0; i < n; i++) {
+            if (seen[i]) continue;
+            int length = 0;
+            for (int j = i; !seen[j]; j = P[j]) {
+                seen[j] = true;
+                length++;
+            }
+            if (length % 2 == 0) sign = -sign;
+        }
+        return sign;
+    }
+
+    Matrix storage;
+    MatrixView lu;
+    std::vector<int> P;
+    bool ok;
+};
+
+// These leave `a` untouched and factor a copy of it, either a fresh one or
+// the caller's workspace, which is reused across calls of the same size. To
+// factor in place, build an LUFactorization on the view directly.
+inline double logAbsDeterminant(MatrixView a, int& sign) {
+    return LUFactorization(Matrix::copyOf(a)).logAbsDeterminant(sign);
+}
+
+inline double logAbsDeterminant(MatrixView a, int& sign, Matrix& workspace) {
+    return LUFactorization(MatrixView(workspace.assign(a))).logAbsDeterminant(sign);
+}
+
+inline double determinant(MatrixView a) {
+    return LUFactorization(Matrix::copyOf(a)).determinant();
+}
+
+inline double determinant(MatrixView a, Matrix& workspace) {
+    return LUFactorization(MatrixView(workspace.assign(a))).determinant();
+}
+
+#endif
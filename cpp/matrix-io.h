@@ -0,0 +1,409 @@
+#ifndef MATRIX_IO_H
+#define MATRIX_IO_H
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include "matrix.h"
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Non-interactive input for the linear solvers. readSystem loads an augmented
+// n x (n + 1) system from a file ("-" for stdin) in one of three formats,
+// detected from the first bytes:
+//
+//   binary        "NUMMAT1\0", int64 rows, int64 cols, then rows * cols
+//                 little-endian doubles in row-major order
+//   MatrixMarket  "%%MatrixMarket matrix array|coordinate real|integer
+//                 general", as written by most sparse tools
+//   text / CSV    one row per line, values separated by spaces, tabs, commas
+//                 or semicolons; blank lines and lines starting with '#' are
+//                 skipped
+//
+// Files are read with a few large reads and numbers are parsed in place with
+// from_chars, so loading costs about as much as the bytes on disk.
+
+const char MATRIX_BINARY_MAGIC[8] = {'N', 'U', 'M', 'M', 'A', 'T', '1', '\0'};
+
+inline bool hostIsLittleEndian() {
+    std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// Reverses the bytes of `count` consecutive 8-byte values.
+inline void byteSwap8(void* data, std::size_t count) {
+    unsigned char* bytes = static_cast<unsigned char*>(data);
+    for (std::size_t i = 0; i < count; i++, bytes += 8) {
+        std::reverse(bytes, bytes + 8);
+    }
+}
+
+inline std::FILE* openInput(const char* path) {
+    if (std::strcmp(path, "-") != 0) return std::fopen(path, "rb");
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+#endif
+    return stdin;
+}
+
+inline void closeInput(std::FILE* file) {
+    if (file && file != stdin) std::fclose(file);
+}
+
+inline bool readAll(std::FILE* file, std::string& buffer) {
+    const std::size_t chunk = 1 << 22;
+    std::size_t used = buffer.size();
+    for (;;) {
+        buffer.resize(used + chunk);
+        std::size_t got = std::fread(&buffer[used], 1, chunk, file);
+        used += got;
+        if (got < chunk) break;
+    }
+    buffer.resize(used);
+    return !std::ferror(file);
+}
+
+inline bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r';
+}
+
+// Parses the numbers of one line into out (at most `limit` of them) and
+// returns how many there were, or -1 if something was not a number.
+inline int parseLine(const char* p, const char* end, double* out, int limit) {
+    int count = 0;
+    for (;;) {
+        while (p < end && isSeparator(*p)) p++;
+        if (p == end) return count;
+        if (*p == '+') p++;
+        double value;
+        std::from_chars_result r = std::from_chars(p, end, value);
+        if (r.ec != std::errc()) return -1;
+        if (count < limit) out[count] = value;
+        count++;
+        p = r.ptr;
+    }
+}
+
+inline const char* lineEnd(const char* p, const char* end) {
+    const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return nl ? nl : end;
+}
+
+inline bool isDataLine(const char* p, const char* end, char comment) {
+    while (p < end && isSeparator(*p)) p++;
+    return p < end && *p != comment;
+}
+
+inline bool readTextSystem(const std::string& text, Matrix& matrix, int& n, std::string& error) {
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+
+    n = 0;
+    for (const char* p = begin; p < end; p = lineEnd(p, end) + 1) {
+        if (isDataLine(p, lineEnd(p, end), '#')) n++;
+    }
+    if (n == 0) {
+        error = "input contains no rows";
+        return false;
+    }
+
+    matrix = Matrix(n, n + 1);
+    int row = 0;
+    for (const char* p = begin; p < end; p = lineEnd(p, end) + 1) {
+        const char* e = lineEnd(p, end);
+        if (!isDataLine(p, e, '#')) continue;
+        int count = parseLine(p, e, matrix[row], n + 1);
+        if (count != n + 1) {
+            error = "row " + std::to_string(row + 1) + (count < 0 ? " contains a value that is not a number" : " has " + std::to_string(count) + " values, expected " + std::to_string(n + 1));
+            return false;
+        }
+        row++;
+    }
+    return true;
+}
+
+// Allocates the n x (n + 1) system, reporting a size the machine cannot hold
+// as an error instead of letting std::bad_alloc end the program.
+inline bool allocateSystem(Matrix& matrix, int n, std::string& error) {
+    try {
+        matrix = Matrix(n, n + 1);
+    } catch (const std::bad_alloc&) {
+        error = "not enough memory for a " + std::to_string(n) + " x " + std::to_string(n + 1) + " system";
+        return false;
+    }
+    return true;
+}
+
+inline bool readMatrixMarketSystem(const std::string& text, Matrix& matrix, int& n, std::string& error) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    const char* e = lineEnd(p, end);
+    std::string header(p, e);
+    for (char& c : header) {
+        c = (char)std::tolower((unsigned char)c);
+    }
+
+    bool coordinate = header.find("coordinate") != std::string::npos;
+    bool real = header.find("real") != std::string::npos || header.find("integer") != std::string::npos;
+    if ((!coordinate && header.find("array") == std::string::npos) || !real || header.find("general") == std::string::npos) {
+        error = "unsupported MatrixMarket type: " + std::string(p, e);
+        return false;
+    }
+
+    p = e + 1;
+    while (p < end && !isDataLine(p, lineEnd(p, end), '%')) {
+        p = lineEnd(p, end) + 1;
+    }
+    double size[3];
+    int sizeCount = p < end ? parseLine(p, lineEnd(p, end), size, 3) : 0;
+    if (sizeCount != (coordinate ? 3 : 2)) {
+        error = "missing MatrixMarket size line";
+        return false;
+    }
+    if (!(size[0] > 0 && size[0] < (1 << 30) && size[1] > 0 && size[1] <= (1 << 30))) {
+        error = "invalid MatrixMarket size " + std::string(p, lineEnd(p, end));
+        return false;
+    }
+    int rows = (int)size[0], cols = (int)size[1];
+    if (cols != rows + 1) {
+        error = "expected an n x (n+1) augmented matrix, got " + std::to_string(rows) + " x " + std::to_string(cols);
+        return false;
+    }
+    // Every dense entry takes at least two bytes ("0\n").
+    if (!coordinate && (double)rows * cols * 2 > (double)text.size()) {
+        error = "MatrixMarket file is too short for a " + std::to_string(rows) + " x " + std::to_string(cols) + " array";
+        return false;
+    }
+    n = rows;
+    if (!allocateSystem(matrix, n, error)) return false;
+
+    long long entries = coordinate ? (long long)size[2] : (long long)rows * cols;
+    long long read = 0;
+    for (p = lineEnd(p, end) + 1; p < end && read < entries; p = lineEnd(p, end) + 1) {
+        e = lineEnd(p, end);
+        if (!isDataLine(p, e, '%')) continue;
+        if (coordinate) {
+            double v[3];
+            if (parseLine(p, e, v, 3) != 3) {
+                error = "bad MatrixMarket entry " + std::to_string(read + 1);
+                return false;
+            }
+            int i = (int)v[0] - 1, j = (int)v[1] - 1;
+            if (i < 0 || i >= rows || j < 0 || j >= cols) {
+                error = "MatrixMarket entry " + std::to_string(read + 1) + " is out of range";
+                return false;
+            }
+            matrix[i][j] = v[2];
+        } else {
+            // Dense arrays are stored column by column.
+            double v;
+            if (parseLine(p, e, &v, 1) != 1) {
+                error = "bad MatrixMarket entry " + std::to_string(read + 1);
+                return false;
+            }
+            matrix[(int)(read % rows)][(int)(read / rows)] = v;
+        }
+        read++;
+    }
+    if (read < entries) {
+        error = "MatrixMarket file ends after " + std::to_string(read) + " of " + std::to_string(entries) + " entries";
+        return false;
+    }
+    return true;
+}
+
+inline bool readBinarySystem(std::FILE* file, Matrix& matrix, int& n, std::string& error) {
+    std::int64_t dims[2];
+    if (std::fread(dims, sizeof(dims), 1, file) != 1) {
+        error = "truncated binary header";
+        return false;
+    }
+    if (!hostIsLittleEndian()) {
+        byteSwap8(dims, 2);
+    }
+    if (dims[0] <= 0 || dims[0] >= (1 << 30) || dims[1] != dims[0] + 1) {
+        error = "expected an n x (n+1) augmented matrix in the binary header";
+        return false;
+    }
+#ifndef _WIN32
+    // A regular file must hold every value the header promises, so a corrupt
+    // header cannot make us allocate far more than the file could fill.
+    struct stat st;
+    long offset = std::ftell(file);
+    if (offset >= 0 && fstat(fileno(file), &st) == 0 && S_ISREG(st.st_mode) && (std::size_t)(st.st_size - offset) < (std::size_t)dims[0] * dims[1] * sizeof(double)) {
+        error = "binary file is too short for its " + std::to_string(dims[0]) + " x " + std::to_string(dims[1]) + " header";
+        return false;
+    }
+#endif
+
+    n = (int)dims[0];
+    if (!allocateSystem(matrix, n, error)) return false;
+    for (int i = 0; i < n; i++) {
+        if (std::fread(matrix[i], sizeof(double), n + 1, file) != (std::size_t)(n + 1)) {
+            error = "binary file ends at row " + std::to_string(i + 1);
+            return false;
+        }
+        if (!hostIsLittleEndian()) byteSwap8(matrix[i], n + 1);
+    }
+    return true;
+}
+
+inline bool readSystem(const char* path, Matrix& matrix, int& n, std::string& error) {
+    std::FILE* file = openInput(path);
+    if (!file) {
+        error = std::string("cannot open ") + path;
+        return false;
+    }
+
+    std::string buffer(sizeof(MATRIX_BINARY_MAGIC), '\0');
+    buffer.resize(std::fread(&buffer[0], 1, buffer.size(), file));
+
+    bool ok;
+    if (buffer.size() == sizeof(MATRIX_BINARY_MAGIC) && std::memcmp(buffer.data(), MATRIX_BINARY_MAGIC, sizeof(MATRIX_BINARY_MAGIC)) == 0) {
+        ok = readBinarySystem(file, matrix, n, error);
+    } else if (!readAll(file, buffer)) {
+        error = std::string("error reading ") + path;
+        ok = false;
+    } else if (buffer.compare(0, 14, "%%MatrixMarket") == 0) {
+        ok = readMatrixMarketSystem(buffer, matrix, n, error);
+    } else {
+        ok = readTextSystem(buffer, matrix, n, error);
+    }
+
+    closeInput(file);
+    return ok;
+}
+
+// A binary system file mapped straight into memory and used as the solver's
+// working buffer, so a system larger than comfortably fits twice in RAM is
+// never read or copied. The rows are the file's rows, n + 1 doubles apart.
+// By default the mapping is private: pages are copied only when the solver
+// first writes them and the file is left untouched. With inPlace the mapping
+// is shared and the solver's updates are written back to the file. Mapped
+// rows are not cache-line aligned, so elimination runs somewhat slower than
+// on a loaded Matrix; map only when the copy is what hurts.
+class MappedSystem {
+public:
+    MappedSystem() {}
+    ~MappedSystem() { close(); }
+
+    MappedSystem(const MappedSystem&) = delete;
+    MappedSystem& operator=(const MappedSystem&) = delete;
+
+    // Returns false, leaving the object empty and error set, when the file
+    // cannot be mapped: not a regular binary system file, big-endian host,
+    // or a platform without mmap. Without inPlace the caller can still load
+    // it with readSystem; with inPlace it must report the error, since the
+    // results could not be written back.
+    bool open(const char* path, bool inPlace, std::string& error) {
+        close();
+#ifdef _WIN32
+        (void)path;
+        (void)inPlace;
+        error = "memory-mapped input is not supported on this platform";
+        return false;
+#else
+        const std::size_t header = sizeof(MATRIX_BINARY_MAGIC) + 2 * sizeof(std::int64_t);
+        if (std::strcmp(path, "-") == 0) {
+            error = "standard input cannot be mapped";
+            return false;
+        }
+        if (!hostIsLittleEndian()) {
+            error = "binary files cannot be mapped on a big-endian host";
+            return false;
+        }
+        int fd = ::open(path, inPlace ? O_RDWR : O_RDONLY);
+        if (fd < 0) {
+            error = std::string("cannot open ") + path + (inPlace ? " for writing: " : ": ") + std::strerror(errno);
+            return false;
+        }
+
+        struct stat st;
+        char head[header];
+        std::int64_t dims[2] = {0, 0};
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && pread(fd, head, header, 0) == (ssize_t)header && std::memcmp(head, MATRIX_BINARY_MAGIC, sizeof(MATRIX_BINARY_MAGIC)) == 0) {
+            std::memcpy(dims, head + sizeof(MATRIX_BINARY_MAGIC), sizeof(dims));
+        }
+        bool fits = dims[0] > 0 && dims[0] < (1 << 30) && dims[1] == dims[0] + 1 && (std::size_t)st.st_size >= header + (std::size_t)dims[0] * dims[1] * sizeof(double);
+        void* p = fits ? mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, inPlace ? MAP_SHARED : MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        if (!fits) {
+            error = std::string(path) + " is not a complete binary system file";
+        } else if (p == MAP_FAILED) {
+            error = std::string("cannot map ") + path + ": " + std::strerror(errno);
+        } else {
+            base = p;
+            length = st.st_size;
+            n = (int)dims[0];
+            view = MatrixView(reinterpret_cast<double*>(static_cast<char*>(p) + header), n, n + 1, n + 1);
+        }
+        ::close(fd);
+        return base != nullptr;
+#endif
+    }
+
+    void close() {
+#ifndef _WIN32
+        if (base) munmap(base, length);
+#endif
+        base = nullptr;
+        length = 0;
+        n = 0;
+        view = MatrixView();
+    }
+
+    int size() const { return n; }
+    MatrixView matrix() const { return view; }
+
+private:
+    void* base = nullptr;
+    std::size_t length = 0;
+    int n = 0;
+    MatrixView view;
+};
+
+// Writes the binary format read by readSystem.
+inline bool writeBinaryMatrix(const char* path, const MatrixView& matrix) {
+    std::FILE* file = std::strcmp(path, "-") == 0 ? stdout : std::fopen(path, "wb");
+    if (!file) return false;
+
+    std::int64_t dims[2] = {matrix.rows(), matrix.cols()};
+    std::vector<double> row(matrix.cols());
+    bool swap = !hostIsLittleEndian();
+    if (swap) byteSwap8(dims, 2);
+    bool ok = std::fwrite(MATRIX_BINARY_MAGIC, sizeof(MATRIX_BINARY_MAGIC), 1, file) == 1 && std::fwrite(dims, sizeof(dims), 1, file) == 1;
+    for (int i = 0; ok && i < matrix.rows(); i++) {
+        const double* src = matrix[i];
+        if (swap) {
+            row.assign(src, src + matrix.cols());
+            byteSwap8(row.data(), row.size());
+            src = row.data();
+        }
+        ok = std::fwrite(src, sizeof(double), matrix.cols(), file) == (std::size_t)matrix.cols();
+    }
+
+    if (file == stdout) {
+        ok = std::fflush(file) == 0 && ok;
+    } else {
+        ok = std::fclose(file) == 0 && ok;
+    }
+    return ok;
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Non-owning view of a row-major block of doubles. Rows are `stride` doubles
+// apart, so a view can describe a whole matrix or any sub-block of one.
+class MatrixView {
+public:
+    MatrixView() : ptr(nullptr), nRows(0), nCols(0), ld(0) {}
+    MatrixView(double* data, int rows, int cols, int stride)
+        : ptr(data), nRows(rows), nCols(cols), ld(stride) {}
+
+    int rows() const { return nRows; }
+    int cols() const { return nCols; }
+    int stride() const { return ld; }
+    double* data() const { return ptr; }
+
+    double* row(int i) const { return ptr + (std::size_t)i * ld; }
+    double* operator[](int i) const { return row(i); }
+    double& operator()(int i, int j) const { return row(i)[j]; }
+
+    MatrixView block(int i, int j, int rows, int cols) const {
+        return MatrixView(row(i) + j, rows, cols, ld);
+    }
+
+    void swapRows(int a, int b) const {
+        if (a != b) std::swap_ranges(row(a), row(a) + nCols, row(b));
+    }
+
+protected:
+    double* ptr;
+    int nRows, nCols, ld;
+};
+
+// Dense row-major matrix backed by one cache-line aligned buffer. The stride
+// is padded to a whole number of cache lines so every row starts aligned.
+class Matrix : public MatrixView {
+public:
+    static const int alignment = 64;
+
+    Matrix() {}
+    Matrix(int rows, int cols) { allocate(rows, cols); }
+    Matrix(const Matrix& other) : MatrixView() { copyFrom(other); }
+    Matrix(Matrix&& other) noexcept : MatrixView(other) { other.reset(); }
+    ~Matrix() { release(); }
+
+    Matrix& operator=(const Matrix& other) {
+        if (this != &other) {
+            release();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    Matrix& operator=(Matrix&& other) noexcept {
+        if (this != &other) {
+            release();
+            MatrixView::operator=(other);
+            other.reset();
+        }
+        return *this;
+    }
+
+    // Copies src into this matrix, reallocating only when the shape differs,
+    // so one workspace can take a solver's scratch copy call after call.
+    Matrix& assign(const MatrixView& src) {
+        if (src.rows() != nRows || src.cols() != nCols) {
+            release();
+            allocate(src.rows(), src.cols());
+        }
+        for (int i = 0; i < nRows; i++) {
+            std::copy(src[i], src[i] + nCols, row(i));
+        }
+        return *this;
+    }
+
+    static Matrix copyOf(const MatrixView& src) {
+        Matrix m(src.rows(), src.cols());
+        for (int i = 0; i < src.rows(); i++) {
+            std::copy(src[i], src[i] + src.cols(), m[i]);
+        }
+        return m;
+    }
+
+private:
+    static int paddedStride(int cols) {
+        const int perLine = alignment / sizeof(double);
+        return (cols + perLine - 1) / perLine * perLine;
+    }
+
+    void allocate(int rows, int cols) {
+        nRows = rows;
+        nCols = cols;
+        ld = paddedStride(cols);
+        std::size_t count = (std::size_t)rows * ld;
+        ptr = count ? static_cast<double*>(::operator new(count * sizeof(double), std::align_val_t(alignment))) : nullptr;
+        std::fill(ptr, ptr + count, 0.0);
+    }
+
+    void copyFrom(const Matrix& other) {
+        allocate(other.nRows, other.nCols);
+        std::copy(other.ptr, other.ptr + (std::size_t)nRows * ld, ptr);
+    }
+
+    void release() {
+        if (ptr) ::operator delete(ptr, std::align_val_t(alignment));
+        reset();
+    }
+
+    void reset() {
+        ptr = nullptr;
+        nRows = nCols = ld = 0;
+    }
+};
+
+#endif
@@ -1,101 +1,120 @@
 #include <iostream>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <vector>
+#include "expression.h"
+#include "polynomial-roots.h"
+#include "root-finding.h"
 
 using namespace std;
 
-double evaluatePolynomial(const vector<double>& coeffs, double x) {
-    double result = 0.0;
-    for (int i = 0; i < coeffs.size(); i++) {
-        result += coeffs[i] * pow(x, coeffs.size() - 1 - i);
-    }
-    return result;
-}
-
-vector<double> computeDerivative(const vector<double>& coeffs) {
-    int degree = coeffs.size() - 1;
-    if (degree == 0) return {0.0}; 
-    vector<double> deriv_coeffs(degree);
-    for (int i = 0; i < degree; i++) {
-        deriv_coeffs[i] = coeffs[i] * (degree - i);
+void printPolynomial(const vector<double>& coeffs) {
+    int degree = (int)coeffs.size() - 1;
+    for (int i = 0; i <= degree; i++) {
+        cout << coeffs[i] << "x^" << (degree - i);
+        if (i < degree) cout << " + ";
     }
-    return deriv_coeffs;
+    cout << "\n";
 }
 
-void newtonRaphsonMethod(const vector<double>& coeffs, double x0, double tol, int maxIter) {
-    vector<double> deriv_coeffs = computeDerivative(coeffs);
-
+void printHeader(double x0, double tol, int maxIter) {
     cout << "\nNewton-Raphson Method for root finding:\n";
     cout << "Initial guess: x0 = " << x0 << "\n";
     cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n\n";
-    cout << "f(x) = ";
-    for (int i = 0; i < coeffs.size(); i++) {
-        cout << coeffs[i] << "x^" << (coeffs.size() - 1 - i);
-        if (i < coeffs.size() - 1) cout << " + ";
+}
+
+void printIterations(const IterationTrace& trace) {
+    cout << "\n" << setw(5) << "Iter" << setw(12) << "xn" << setw(12) << "f(xn)" << setw(12) << "f'(xn)" << setw(12) << "xn+1" << endl;
+    cout << string(60, '-') << endl;
+    if (trace.total() > (unsigned long long)trace.size()) {
+        cout << "(" << trace.total() - trace.size() << " earlier iterations not kept)\n";
     }
-    cout << "\n";
-    cout << "f'(x) = ";
-    for (int i = 0; i < deriv_coeffs.size(); i++) {
-        cout << deriv_coeffs[i] << "x^" << (deriv_coeffs.size() - 1 - i);
-        if (i < deriv_coeffs.size() - 1) cout << " + ";
+    for (int i = 0; i < trace.size(); i++) {
+        const IterationRecord& r = trace[i];
+        cout << setw(5) << r.iteration << fixed << setprecision(6);
+        for (int k = 0; k < 4; k++) {
+            cout << setw(12) << r.values[k];
+        }
+        cout << "\n";
     }
-    cout << "\n\n";
-    cout << setw(5) << "Iter" << setw(12) << "xn" << setw(12) << "f(xn)" 
-         << setw(12) << "f'(xn)" << setw(12) << "xn+1" << endl;
-    cout << string(60, '-') << endl;
-
-    double x = x0;
-    int iter = 0;
-
-    while (iter < maxIter) {
-        double fx = evaluatePolynomial(coeffs, x);
-        double fpx = evaluatePolynomial(deriv_coeffs, x);
+}
 
-        if (abs(fpx) < 1e-10) {
-            cout << "Error: Derivative is too close to zero, method fails.\n";
-            return;
+// Formats the roots from --all-roots; real roots are printed without an
+// imaginary part.
+void printRoots(const vector<double>& coeffs, const PolynomialRoots& result) {
+    cout << "\n" << setw(5) << "k" << setw(20) << "Re(x)" << setw(20) << "Im(x)" << setw(14) << "|f(x)|" << endl;
+    cout << string(59, '-') << endl;
+    for (size_t k = 0; k < result.roots.size(); k++) {
+        Complex x = result.roots[k], p = 0;
+        for (double c : coeffs) {
+            p = p * x + c;
         }
+        cout << setw(5) << k + 1 << fixed << setprecision(12) << setw(20) << x.real();
+        if (x.imag() != 0) {
+            cout << setw(20) << x.imag();
+        } else {
+            cout << setw(20) << "";
+        }
+        cout << scientific << setprecision(3) << setw(14) << abs(p) << "\n";
+    }
+}
 
-        double xn = x - fx / fpx;
-
-        cout << setw(5) << iter + 1 
-             << setw(12) << fixed << setprecision(6) << x 
-             << setw(12) << fx 
-             << setw(12) << fpx 
-             << setw(12) << xn << endl;
-
-        if (abs(xn - x) < tol || abs(fx) < tol) break;
-
-        x = xn;
-        iter++;
+// An argument other than --all-roots is f(x) as an expression, e.g.
+// "cos(x) - x"; f'(x) is then computed by automatic differentiation.
+// Otherwise f is a polynomial read from the prompts, and --all-roots finds
+// all of its roots, complex ones included, instead of one from x0.
+int main(int argc, char* argv[]) {
+    const char* text = nullptr;
+    bool allRoots = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--all-roots") == 0) {
+            allRoots = true;
+        } else {
+            text = argv[i];
+        }
+    }
+    if (text && allRoots) {
+        cout << "Error: --all-roots needs a polynomial, not an expression.\n";
+        return 1;
     }
 
-    cout << "\nAfter " << iter << " iterations:\n";
-    cout << "Approximate root: x = " << x << "\n";
-    cout << "Function value at root: f(x) = " << evaluatePolynomial(coeffs, x) << "\n";
-}
+    Expression expr;
+    if (text) {
+        string error;
+        if (!compileExpression(text, expr, error)) {
+            cout << "Error: " << error << "\n";
+            return 1;
+        }
+    }
 
-int main() {
-    int degree;
     double x0, tol;
     int maxIter;
+    vector<double> coeffs;
 
     cout << "Newton-Raphson Method for Root Finding\n";
-    cout << "Enter a polynomial f(x) = a_n x^n + ... + a_1 x + a_0 to solve f(x) = 0\n\n";
-
-    cout << "Enter the degree of the polynomial: ";
-    cin >> degree;
-
-    vector<double> coeffs(degree + 1);
-    cout << "Enter the coefficients from highest to lowest degree (a_n to a_0):\n";
-    for (int i = 0; i <= degree; i++) {
-        cout << "Coefficient of x^" << (degree - i) << ": ";
-        cin >> coeffs[i];
+    if (text) {
+        cout << "Function: f(x) = " << text << "\n\n";
+    } else {
+        cout << "Enter a polynomial f(x) = a_n x^n + ... + a_1 x + a_0 to solve f(x) = 0\n";
+        cout << "(or pass f(x) as the first argument)\n\n";
+
+        int degree;
+        cout << "Enter the degree of the polynomial: ";
+        cin >> degree;
+
+        coeffs.resize(degree + 1);
+        cout << "Enter the coefficients from highest to lowest degree (a_n to a_0):\n";
+        for (int i = 0; i <= degree; i++) {
+            cout << "Coefficient of x^" << (degree - i) << ": ";
+            cin >> coeffs[i];
+        }
     }
 
-    cout << "Enter the initial guess x0: ";
-    cin >> x0;
+    if (!allRoots) {
+        cout << "Enter the initial guess x0: ";
+        cin >> x0;
+    }
     cout << "Enter the tolerance (e.g., 0.001): ";
     cin >> tol;
     cout << "Enter the maximum number of iterations (e.g., 20): ";
@@ -110,6 +129,53 @@ int main() {
         return 1;
     }
 
-    newtonRaphsonMethod(coeffs, x0, tol, maxIter);
+    if (allRoots) {
+        if (coeffs.empty() || coeffs[0] == 0) {
+            cout << "Error: The leading coefficient must be nonzero.\n";
+            return 1;
+        }
+        cout << "\nAberth-Ehrlich method for all roots of f(x) = ";
+        printPolynomial(coeffs);
+        cout << "Tolerance: " << tol << ", Max iterations: " << maxIter << "\n";
+        PolynomialRoots result = aberthRoots(coeffs, tol, maxIter);
+        printRoots(coeffs, result);
+        cout << "\nAfter " << result.iterations << " iterations, " << result.evaluations << " evaluations of f and f'\n";
+        if (result.companion) {
+            cout << "The iteration did not converge; roots are the companion matrix eigenvalues.\n";
+        }
+        if (result.status == SolveStatus::MaxIterations) {
+            cout << "Warning: " << statusMessage(result.status) << ".\n";
+        }
+        return 0;
+    }
+
+    printHeader(x0, tol, maxIter);
+    IterationTrace trace;
+    RootResult result;
+    if (text) {
+        cout << "f(x) = " << text << "\n";
+        cout << "f'(x) by automatic differentiation\n";
+        result = newtonRaphsonMethod(expr, x0, tol, maxIter, trace);
+    } else {
+        cout << "f(x) = ";
+        printPolynomial(coeffs);
+        cout << "f'(x) = ";
+        printPolynomial(computeDerivative(coeffs));
+        result = newtonRaphsonMethod(coeffs, x0, tol, maxIter, trace);
+    }
+    printIterations(trace);
+    if (result.status == SolveStatus::ZeroDerivative) {
+        cout << "Error: Derivative is too close to zero, method fails.\n";
+        return 1;
+    }
+
+    cout << "\nAfter " << result.iterations << " iterations:\n";
+    cout << fixed << setprecision(6);
+    cout << "Approximate root: x = " << result.root << "\n";
+    cout << "Function value at root: f(x) = " << result.residual << "\n";
+    cout << "Function evaluations: " << result.evaluations << "\n";
+    if (result.status == SolveStatus::MaxIterations) {
+        cout << "Warning: " << statusMessage(result.status) << ".\n";
+    }
 
 }
\ No newline at end of file
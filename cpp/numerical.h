@@ -0,0 +1,25 @@
+#ifndef NUMERICAL_H
+#define NUMERICAL_H
+
+// The numerical library: every solver behind the command-line programs,
+// returning result structs instead of printing. Header-only, so using it
+// means including this file (or one of the headers below) and compiling with
+// -std=c++17 -pthread.
+
+#include "batch-roots.h"
+#include "batch-solver.h"
+#include "dual.h"
+#include "expression-jit.h"
+#include "expression.h"
+#include "fixed-point.h"
+#include "fixed-solver.h"
+#include "linear-solvers.h"
+#include "lu.h"
+#include "matrix-io.h"
+#include "matrix.h"
+#include "polynomial-roots.h"
+#include "polynomial.h"
+#include "root-finding.h"
+#include "solve-status.h"
+
+#endif
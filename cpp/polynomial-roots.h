@@ -0,0 +1,387 @@
+#ifndef POLYNOMIAL_ROOTS_H
+#define POLYNOMIAL_ROOTS_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+#include "matrix.h"
+#include "solve-status.h"
+#include "thread-pool.h"
+
+// Every root of a polynomial at once, coefficients ordered as in
+// polynomial.h (highest degree first). The Aberth-Ehrlich iteration moves
+// all n approximations together; root k takes the Newton correction of p
+// deflated by the other approximations,
+//
+//     z(k) -= 1 / (p'(z(k)) / p(z(k)) - sum over j != k of 1 / (z(k) - z(j)))
+//
+// which converges cubically to simple roots from starting points that need
+// not be close, and keeps approximations from collapsing onto the same
+// root. Each step reads only the previous approximations, so the updates are
+// independent and high degrees split them across threads. If the iteration
+// does not settle, the roots are taken as the eigenvalues of the companion
+// matrix instead (balanced, Francis double-shift QR).
+
+typedef std::complex<double> Complex;
+
+// From this degree on the root updates are split across threads.
+const int ROOTS_PARALLEL_MIN_DEGREE = 128;
+
+struct PolynomialRoots {
+    std::vector<Complex> roots;  // sorted by real, then imaginary part
+    int iterations;
+    int evaluations;             // p and p' evaluated together count once
+    SolveStatus status;
+    bool companion;              // the companion-matrix fallback was used
+};
+
+// Starting points on circles whose radii come from the upper convex hull of
+// (k, log |a_k|), a_k being the coefficient of x^k: each hull edge from k0
+// to k1 stands for k1 - k0 roots of modulus about (|a_k0| / |a_k1|)^(1 /
+// (k1 - k0)). This matters for high degrees with coefficients of very
+// different sizes, where a single circle starts most points far off.
+inline std::vector<Complex> aberthStart(const std::vector<double>& c) {
+    int n = (int)c.size() - 1;
+    std::vector<int> hull;
+    std::vector<double> logA(n + 1);
+    for (int k = 0; k <= n; k++) {
+        double a = std::abs(c[n - k]);
+        logA[k] = a > 0 ? std::log(a) : -std::numeric_limits<double>::infinity();
+        if (a == 0) continue;
+        while (hull.size() >= 2) {
+            int i = hull[hull.size() - 2], j = hull.back();
+            if ((logA[j] - logA[i]) * (k - i) > (logA[k] - logA[i]) * (j - i)) break;
+            hull.pop_back();
+        }
+        hull.push_back(k);
+    }
+
+    const double pi = std::acos(-1.0);
+    std::vector<Complex> z;
+    for (size_t h = 0; h + 1 < hull.size(); h++) {
+        int k0 = hull[h], k1 = hull[h + 1], m = k1 - k0;
+        double r = std::exp((logA[k0] - logA[k1]) / m);
+        for (int j = 0; j < m; j++) {
+            z.push_back(std::polar(r, 2 * pi * j / m + 2 * pi * h / n + 0.7));
+        }
+    }
+    return z;
+}
+
+// Newton quotient p'(z) / p(z) by Horner's scheme in real arithmetic. For
+// |z| > 1 the reversed polynomial is evaluated at 1/z instead, so high
+// degrees do not overflow. Returns true once |p(z)| is within the rounding
+// error of its own evaluation, i.e. z is a root of a nearby polynomial.
+inline bool newtonQuotient(const std::vector<double>& c, Complex z, Complex& quotient) {
+    int n = (int)c.size() - 1;
+    bool reversed = std::abs(z) > 1;
+    Complex y = reversed ? 1.0 / z : z;
+    double yr = y.real(), yi = y.imag(), r = std::abs(y);
+    double pr = reversed ? c[n] : c[0], pi = 0, dr = 0, di = 0, bound = std::abs(pr);
+    for (int i = 1; i <= n; i++) {
+        double a = reversed ? c[n - i] : c[i];
+        double t = dr * yr - di * yi + pr;
+        di = dr * yi + di * yr + pi;
+        dr = t;
+        t = pr * yr - pi * yi + a;
+        pi = pr * yi + pi * yr;
+        pr = t;
+        bound = bound * r + std::abs(a);
+    }
+
+    Complex p(pr, pi), d(dr, di);
+    if (p == 0.0) {
+        quotient = std::numeric_limits<double>::infinity();
+        return true;
+    }
+    quotient = reversed ? (double(n) - y * d / p) * y : d / p;
+    return std::abs(p) <= std::numeric_limits<double>::epsilon() * bound;
+}
+
+// Balances a (scales rows and columns by powers of two so their norms are
+// comparable) and returns its eigenvalues with the Francis double-shift QR
+// iteration. a must be upper Hessenberg; it is overwritten. False if an
+// eigenvalue needs more than maxIter iterations.
+inline bool hessenbergEigenvalues(MatrixView a, std::vector<Complex>& eigenvalues, int maxIter = 60) {
+    int n = a.rows();
+    for (bool done = false; !done;) {
+        done = true;
+        for (int i = 0; i < n; i++) {
+            double col = 0, row = 0;
+            for (int j = 0; j < n; j++) {
+                if (j == i) continue;
+                col += std::abs(a[j][i]);
+                row += std::abs(a[i][j]);
+            }
+            // Overflowed sums would keep the scaling loops below going forever.
+            if (col == 0 || row == 0 || !std::isfinite(col) || !std::isfinite(row)) continue;
+            double f = 1, s = col + row;
+            while (col < row / 2) {
+                f *= 2;
+                col *= 4;
+            }
+            while (col > row * 2) {
+                f /= 2;
+                col /= 4;
+            }
+            if ((col + row) / f < 0.95 * s) {
+                done = false;
+                for (int j = 0; j < n; j++) {
+                    a[i][j] /= f;
+                    a[j][i] *= f;
+                }
+            }
+        }
+    }
+
+    double norm = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = std::max(i - 1, 0); j < n; j++) {
+            norm += std::abs(a[i][j]);
+        }
+    }
+    eigenvalues.assign(n, 0.0);
+    double shift = 0;
+    int nn = n - 1, l = 0;
+    while (nn >= 0) {
+        int its = 0;
+        do {
+            // Look for a negligible subdiagonal element to split at.
+            for (l = nn; l >= 1; l--) {
+                double s = std::abs(a[l - 1][l - 1]) + std::abs(a[l][l]);
+                if (s == 0) s = norm;
+                if (std::abs(a[l][l - 1]) + s == s) {
+                    a[l][l - 1] = 0;
+                    break;
+                }
+            }
+            double x = a[nn][nn];
+            if (l == nn) {
+                eigenvalues[nn--] = x + shift;
+                continue;
+            }
+            double y = a[nn - 1][nn - 1], w = a[nn][nn - 1] * a[nn - 1][nn];
+            if (l == nn - 1) {
+                double p = 0.5 * (y - x), q = p * p + w, z = std::sqrt(std::abs(q));
+                x += shift;
+                if (q >= 0) {
+                    z = p + std::copysign(z, p);
+                    eigenvalues[nn - 1] = eigenvalues[nn] = x + z;
+                    if (z != 0) eigenvalues[nn] = x - w / z;
+                } else {
+                    eigenvalues[nn - 1] = Complex(x + p, z);
+                    eigenvalues[nn] = Complex(x + p, -z);
+                }
+                nn -= 2;
+                continue;
+            }
+
+            if (its == maxIter) return false;
+            if (its == 10 || its == 20) {
+                // Exceptional shift to break a cycle.
+                shift += x;
+                for (int i = 0; i <= nn; i++) {
+                    a[i][i] -= x;
+                }
+                double s = std::abs(a[nn][nn - 1]) + std::abs(a[nn - 1][nn - 2]);
+                y = x = 0.75 * s;
+                w = -0.4375 * s * s;
+            }
+            its++;
+
+            // Start the double-shift sweep at the lowest row where two
+            // consecutive subdiagonal elements are small.
+            int m;
+            double p = 0, q = 0, r = 0, z;
+            for (m = nn - 2; m >= l; m--) {
+                z = a[m][m];
+                r = x - z;
+                double s = y - z;
+                p = (r * s - w) / a[m + 1][m] + a[m][m + 1];
+                q = a[m + 1][m + 1] - z - r - s;
+                r = a[m + 2][m + 1];
+                s = std::abs(p) + std::abs(q) + std::abs(r);
+                p /= s;
+                q /= s;
+                r /= s;
+                if (m == l) break;
+                double u = std::abs(a[m][m - 1]) * (std::abs(q) + std::abs(r));
+                double v = std::abs(p) * (std::abs(a[m - 1][m - 1]) + std::abs(z) + std::abs(a[m + 1][m + 1]));
+                if (u + v == v) break;
+            }
+            for (int i = m + 2; i <= nn; i++) {
+                a[i][i - 2] = 0;
+                if (i != m + 2) a[i][i - 3] = 0;
+            }
+
+            // Chase the bulge down with Householder reflections.
+            for (int k = m; k <= nn - 1; k++) {
+                if (k != m) {
+                    p = a[k][k - 1];
+                    q = a[k + 1][k - 1];
+                    r = k != nn - 1 ? a[k + 2][k - 1] : 0;
+                    x = std::abs(p) + std::abs(q) + std::abs(r);
+                    if (x != 0) {
+                        p /= x;
+                        q /= x;
+                        r /= x;
+                    }
+                }
+                double s = std::copysign(std::sqrt(p * p + q * q + r * r), p);
+                if (s == 0) continue;
+                if (k == m) {
+                    if (l != m) a[k][k - 1] = -a[k][k - 1];
+                } else {
+                    a[k][k - 1] = -s * x;
+                }
+                p += s;
+                x = p / s;
+                y = q / s;
+                z = r / s;
+                q /= p;
+                r /= p;
+                for (int j = k; j <= nn; j++) {
+                    p = a[k][j] + q * a[k + 1][j];
+                    if (k != nn - 1) {
+                        p += r * a[k + 2][j];
+                        a[k + 2][j] -= p * z;
+                    }
+                    a[k + 1][j] -= p * y;
+                    a[k][j] -= p * x;
+                }
+                for (int i = l; i <= std::min(nn, k + 3); i++) {
+                    p = x * a[i][k] + y * a[i][k + 1];
+                    if (k != nn - 1) {
+                        p += z * a[i][k + 2];
+                        a[i][k + 2] -= p * r;
+                    }
+                    a[i][k + 1] -= p * q;
+                    a[i][k] -= p;
+                }
+            }
+        } while (l < nn - 1);
+    }
+    return true;
+}
+
+inline void sortRoots(std::vector<Complex>& roots) {
+    std::sort(roots.begin(), roots.end(), [](const Complex& a, const Complex& b) {
+        return a.real() != b.real() ? a.real() < b.real() : a.imag() < b.imag();
+    });
+}
+
+// Roots as the eigenvalues of the companion matrix: O(n^3) and not as
+// accurate as the iteration for clustered roots, but it always terminates.
+inline PolynomialRoots companionRoots(std::vector<double> c) {
+    while (!c.empty() && c.front() == 0) {
+        c.erase(c.begin());
+    }
+    int zeros = 0;
+    while (c.size() > 1 && c.back() == 0) {
+        c.pop_back();
+        zeros++;
+    }
+    int n = (int)c.size() - 1;
+
+    std::vector<Complex> roots;
+    bool ok = true;
+    if (n > 0) {
+        Matrix h(n, n);
+        for (int i = 0; i < n; i++) {
+            std::fill(h[i], h[i] + n, 0.0);
+            if (i > 0) h[i][i - 1] = 1;
+        }
+        for (int j = 0; j < n; j++) {
+            h[0][j] = -c[j + 1] / c[0];
+        }
+        ok = hessenbergEigenvalues(h, roots);
+        for (const Complex& root : roots) {
+            ok = ok && std::isfinite(root.real()) && std::isfinite(root.imag());
+        }
+    }
+    roots.insert(roots.end(), zeros, 0.0);
+    sortRoots(roots);
+    return {roots, 0, 0, ok ? SolveStatus::Converged : SolveStatus::MaxIterations, true};
+}
+
+// A root stops moving once its step is below tol relative to its modulus
+// or its residual has been down at rounding level for two steps. Roots
+// whose imaginary part is below tol relative to their modulus are returned
+// as real. From ROOTS_PARALLEL_MIN_DEGREE on the updates are split across
+// `threads` threads (<= 0: every hardware thread); the default is serial.
+inline PolynomialRoots aberthRoots(std::vector<double> c, double tol = 1e-12, int maxIter = 100, int threads = 1) {
+    while (!c.empty() && c.front() == 0) {
+        c.erase(c.begin());
+    }
+    int zeros = 0;
+    while (c.size() > 1 && c.back() == 0) {
+        c.pop_back();
+        zeros++;
+    }
+    int n = (int)c.size() - 1;
+
+    std::vector<Complex> z, next;
+    if (n > 0) z = aberthStart(c);
+    next = z;
+    // 0: moving, 1: residual at rounding level once, 2: finished. Stopping
+    // at the first small residual leaves ill-conditioned roots short.
+    std::vector<char> state(std::max(n, 0), 0);
+    int active = std::max(n, 0), iterations = 0, evaluations = 0;
+    bool finite = true;
+
+    ThreadPool pool(n >= ROOTS_PARALLEL_MIN_DEGREE ? threads : 1);
+    while (active > 0 && iterations < maxIter && finite) {
+        iterations++;
+        evaluations += active;
+        pool.parallelFor(0, n, std::max(1, PARALLEL_MIN_WORK / (4 * n)), [&](int lo, int hi) {
+            for (int k = lo; k < hi; k++) {
+                next[k] = z[k];
+                if (state[k] == 2) continue;
+                Complex quotient;
+                bool settled = newtonQuotient(c, z[k], quotient);
+                if (std::isinf(quotient.real())) {
+                    state[k] = 2;
+                    continue;
+                }
+
+                double sr = 0, si = 0, zr = z[k].real(), zi = z[k].imag();
+                for (int j = 0; j < n; j++) {
+                    if (j == k) continue;
+                    double dx = zr - z[j].real(), dy = zi - z[j].imag(), s = 1 / (dx * dx + dy * dy);
+                    sr += dx * s;
+                    si -= dy * s;
+                }
+                Complex step = 1.0 / (quotient - Complex(sr, si));
+                if (!std::isfinite(step.real()) || !std::isfinite(step.imag())) continue;
+                next[k] = z[k] - step;
+                state[k] = settled ? state[k] + 1 : 0;
+                if (std::abs(step) <= tol * std::abs(next[k])) state[k] = 2;
+            }
+        });
+        z.swap(next);
+        active = 0;
+        for (int k = 0; k < n; k++) {
+            active += state[k] != 2;
+            finite = finite && std::isfinite(z[k].real()) && std::isfinite(z[k].imag());
+        }
+    }
+
+    if (active > 0) {
+        PolynomialRoots fallback = companionRoots(c);
+        fallback.roots.insert(fallback.roots.end(), zeros, 0.0);
+        sortRoots(fallback.roots);
+        fallback.iterations = iterations;
+        fallback.evaluations = evaluations;
+        return fallback;
+    }
+    for (Complex& root : z) {
+        if (std::abs(root.imag()) <= tol * std::abs(root)) root = root.real();
+    }
+    z.insert(z.end(), zeros, 0.0);
+    sortRoots(z);
+    return {z, iterations, evaluations, SolveStatus::Converged, false};
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef POLYNOMIAL_H
+#define POLYNOMIAL_H
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "batch-solver.h"
+#include "dual.h"
+
+// Polynomial evaluation. Coefficients run from the highest degree down to the
+// constant term, so c[0] x^n + c[1] x^(n-1) + ... + c[n].
+//
+// Horner's scheme needs n multiply-adds but each depends on the previous one,
+// so for high degrees its latency, not the arithmetic, is the cost. Estrin's
+// scheme combines coefficient pairs with x, then pairs of those with x^2,
+// x^4, ..., which leaves a dependency chain of about log2(n) steps and lets
+// the CPU overlap the rest. That matters when each evaluation waits on the
+// previous one, as in Newton's method; independent points already overlap,
+// so the multi-point path stays with Horner. The kernels are templated on the
+// value type (double, Dual, BatchLanes).
+
+// Estrin pays off from this degree on; above the maximum Horner is used.
+const int ESTRIN_MIN_DEGREE = 12;
+const int ESTRIN_MAX_DEGREE = 127;
+
+template <class T>
+inline T hornerPolynomial(const double* c, int degree, T x) {
+    T p = T() + c[0];
+    for (int i = 1; i <= degree; i++) {
+        p = p * x + c[i];
+    }
+    return p;
+}
+
+template <class T>
+inline T estrinPolynomial(const double* c, int degree, T x) {
+    T level[(ESTRIN_MAX_DEGREE + 2) / 2];
+    int count = 0;
+    for (int i = degree; i >= 0; i -= 2) {
+        level[count++] = i > 0 ? x * c[i - 1] + c[i] : T() + c[i];
+    }
+    T power = x * x;
+    while (count > 1) {
+        int next = 0;
+        for (int i = 0; i < count; i += 2) {
+            level[next++] = i + 1 < count ? level[i + 1] * power + level[i] : level[i];
+        }
+        count = next;
+        if (count > 1) power = power * power;
+    }
+    return level[0];
+}
+
+template <class T>
+inline T polynomialValue(const double* c, int degree, T x) {
+    if (degree >= ESTRIN_MIN_DEGREE && degree <= ESTRIN_MAX_DEGREE) return estrinPolynomial(c, degree, x);
+    return hornerPolynomial(c, degree, x);
+}
+
+inline double evaluatePolynomial(const std::vector<double>& coeffs, double x) {
+    if (coeffs.empty()) return 0.0;
+    return polynomialValue(coeffs.data(), (int)coeffs.size() - 1, x);
+}
+
+// p(x) and p'(x) in one Horner pass that carries the derivative along with
+// the value. (Estrin on dual numbers does twice the multiplications and is
+// slower at every degree.)
+inline Dual<double> evaluatePolynomialWithDerivative(const std::vector<double>& coeffs, double x) {
+    int degree = (int)coeffs.size() - 1;
+    if (degree < 0) return Dual<double>();
+    double p = coeffs[0], d = 0.0;
+    for (int i = 1; i <= degree; i++) {
+        d = d * x + p;
+        p = p * x + coeffs[i];
+    }
+    return Dual<double>(p, d);
+}
+
+inline std::vector<double> computeDerivative(const std::vector<double>& coeffs) {
+    int degree = (int)coeffs.size() - 1;
+    if (degree <= 0) return {0.0};
+    std::vector<double> derivCoeffs(degree);
+    for (int i = 0; i < degree; i++) {
+        derivCoeffs[i] = coeffs[i] * (degree - i);
+    }
+    return derivCoeffs;
+}
+
+// Multi-point evaluation, BATCH_LANES points per vector and two vectors in
+// flight so the Horner chains of neighbouring groups overlap. Each lane runs
+// the same recurrence as the scalar Horner (with derivative) loop.
+BATCH_INLINE void hornerLanes(const double* c, int degree, const BatchLanes& x, BatchLanes& p, BatchLanes& d) {
+    BatchLanes zero = {};
+    p = zero + c[0];
+    d = zero;
+    for (int i = 1; i <= degree; i++) {
+        d = d * x + p;
+        p = p * x + c[i];
+    }
+}
+
+BATCH_INLINE void polynomialGroups(const double* c, int degree, const double* x, double* values, double* derivatives, int count) {
+    const int width = 2 * BATCH_LANES;
+    int s0 = 0;
+    for (; s0 + width <= count; s0 += width) {
+        BatchLanes x0, x1, zero = {};
+        std::memcpy(&x0, x + s0, sizeof(BatchLanes));
+        std::memcpy(&x1, x + s0 + BATCH_LANES, sizeof(BatchLanes));
+        BatchLanes p0 = zero + c[0], p1 = p0, d0 = zero, d1 = zero;
+        if (derivatives) {
+            for (int i = 1; i <= degree; i++) {
+                d0 = d0 * x0 + p0;
+                d1 = d1 * x1 + p1;
+                p0 = p0 * x0 + c[i];
+                p1 = p1 * x1 + c[i];
+            }
+            std::memcpy(derivatives + s0, &d0, sizeof(BatchLanes));
+            std::memcpy(derivatives + s0 + BATCH_LANES, &d1, sizeof(BatchLanes));
+        } else {
+            for (int i = 1; i <= degree; i++) {
+                p0 = p0 * x0 + c[i];
+                p1 = p1 * x1 + c[i];
+            }
+        }
+        std::memcpy(values + s0, &p0, sizeof(BatchLanes));
+        std::memcpy(values + s0 + BATCH_LANES, &p1, sizeof(BatchLanes));
+    }
+    for (; s0 < count; s0 += BATCH_LANES) {
+        int lanes = std::min(BATCH_LANES, count - s0);
+        BatchLanes xs = {}, p, d;
+        std::memcpy(&xs, x + s0, lanes * sizeof(double));
+        hornerLanes(c, degree, xs, p, d);
+        for (int l = 0; l < lanes; l++) {
+            values[s0 + l] = p[l];
+            if (derivatives) derivatives[s0 + l] = d[l];
+        }
+    }
+}
+
+#ifdef ROW_KERNELS_X86
+__attribute__((target("avx512f"))) inline void polynomialBatchAVX512(const double* c, int degree, const double* x, double* values, double* derivatives, int count) {
+    polynomialGroups(c, degree, x, values, derivatives, count);
+}
+
+__attribute__((target("avx2,fma"))) inline void polynomialBatchAVX2(const double* c, int degree, const double* x, double* values, double* derivatives, int count) {
+    polynomialGroups(c, degree, x, values, derivatives, count);
+}
+#endif
+
+// values[s] = p(x[s]) and, if derivatives is not null, derivatives[s] =
+// p'(x[s]) for s < count.
+inline void evaluatePolynomialBatch(const std::vector<double>& coeffs, const double* x, double* values, double* derivatives, int count) {
+    if (coeffs.empty()) {
+        std::fill(values, values + count, 0.0);
+        if (derivatives) std::fill(derivatives, derivatives + count, 0.0);
+        return;
+    }
+    int degree = (int)coeffs.size() - 1;
+#ifdef ROW_KERNELS_X86
+    static const SimdLevel level = detectSimdLevel();
+    if (level == SimdLevel::AVX512) return polynomialBatchAVX512(coeffs.data(), degree, x, values, derivatives, count);
+    if (level == SimdLevel::AVX2) return polynomialBatchAVX2(coeffs.data(), degree, x, values, derivatives, count);
+#endif
+    polynomialGroups(coeffs.data(), degree, x, values, derivatives, count);
+}
+
+#endif
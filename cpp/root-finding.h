@@ -0,0 +1,619 @@
+#ifndef ROOT_FINDING_H
+#define ROOT_FINDING_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "dual.h"
+#include "iteration-trace.h"
+#include "polynomial.h"
+#include "solve-status.h"
+
+// Scalar root finders and the golden-section minimizer. They compute and
+// return; printing belongs to the callers (the command-line programs). Each
+// takes an optional observer (see iteration-trace.h) that is handed one
+// IterationRecord per iteration; the slots are listed with each solver.
+//
+// f is any callable double(double): a lambda, a functor or a function. It is
+// a template parameter, so f is inlined into the iteration loop. Functions
+// known only at run time go through FunctionRef, which instantiates each
+// solver once for all of them. Newton's method also accepts an f that is
+// generic over its argument type, which it differentiates automatically.
+
+// Non-owning, type-erased reference to a double(double) callable. It is two
+// pointers, never allocates, and the callable must outlive it.
+class FunctionRef {
+public:
+    template <class F>
+    FunctionRef(const F& f) : context(&f), call(&invoke<F>) {}
+    FunctionRef(double (*f)(double)) : context(reinterpret_cast<const void*>(f)), call(&invokePointer) {}
+
+    double operator()(double x) const { return call(context, x); }
+
+private:
+    template <class F>
+    static double invoke(const void* f, double x) {
+        return (*static_cast<const F*>(f))(x);
+    }
+
+    static double invokePointer(const void* f, double x) {
+        return reinterpret_cast<double (*)(double)>(f)(x);
+    }
+
+    const void* context;
+    double (*call)(const void*, double);
+};
+
+// evaluations counts calls of f, endpoint checks and the final residual
+// included, so a solver's cost per iteration can be read off directly.
+// bracketWidth is b - a at exit for the bracketing methods and the last step
+// |x(n+1) - x(n)| for the open ones. seconds is only filled by timeSolve,
+// since reading the clock costs as much as a cheap solve.
+struct RootResult {
+    double root;
+    double residual;  // f(root)
+    int iterations;
+    SolveStatus status;
+    int evaluations;
+    double bracketWidth;
+    double seconds;
+};
+
+struct MinimumResult {
+    double x;
+    double value;  // f(x)
+    int iterations;
+    SolveStatus status;
+    int evaluations;
+    double bracketWidth;
+    double seconds;
+};
+
+// Runs solve() and records its wall time in the result, e.g.
+//     RootResult r = timeSolve([&] { return bisectionMethod(f, a, b, tol, maxIter); });
+template <class Solve>
+auto timeSolve(Solve&& solve) -> decltype(solve()) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    auto result = solve();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// The bracketing methods keep f(a) and f(b) from the previous iterations, so
+// each iteration evaluates f exactly once.
+
+// 2 + iterations evaluations, plus one for the residual at the midpoint
+// unless f hit zero exactly. Trace: a, b, c, f(c).
+template <class F, class Observer = NoTrace>
+RootResult bisectionMethod(F&& f, double a, double b, double tol, int maxIter, Observer&& observer = Observer()) {
+    int evaluations = 0;
+    auto eval = [&](double x) {
+        evaluations++;
+        return f(x);
+    };
+
+    double fa = eval(a);
+    double fb = eval(b);
+    if (fa * fb >= 0) {
+        return {a, fa, 0, SolveStatus::InvalidBracket, evaluations, b - a, 0};
+    }
+
+    int iter = 0;
+    bool converged = (b - a) / 2 <= tol;
+    while (iter < maxIter && !converged) {
+        double c = (a + b) / 2;
+        double fc = eval(c);
+        iter++;
+        observer(IterationRecord{iter, {a, b, c, fc}});
+
+        if (std::abs(fc) < 1e-10) {
+            a = b = c;
+            fa = fc;
+        } else if (fa * fc < 0) {
+            b = c;
+        } else {
+            a = c;
+            fa = fc;
+        }
+        converged = (b - a) / 2 <= tol;
+    }
+
+    double root = (a + b) / 2;
+    double residual = a == b ? fa : eval(root);
+    return {root, residual, iter, converged ? SolveStatus::Converged : SolveStatus::MaxIterations, evaluations, b - a, 0};
+}
+
+// 2 + iterations evaluations. Trace: a, b, c, f(c).
+template <class F, class Observer = NoTrace>
+RootResult falsePositionMethod(F&& f, double a, double b, double tol, int maxIter, Observer&& observer = Observer()) {
+    int evaluations = 0;
+    auto eval = [&](double x) {
+        evaluations++;
+        return f(x);
+    };
+
+    double fa = eval(a);
+    double fb = eval(b);
+    if (fa * fb >= 0) {
+        return {a, fa, 0, SolveStatus::InvalidBracket, evaluations, b - a, 0};
+    }
+
+    double c = a, fc = fa;
+    for (int iter = 1; iter <= maxIter; iter++) {
+        c = (a * fb - b * fa) / (fb - fa);
+        fc = eval(c);
+        observer(IterationRecord{iter, {a, b, c, fc}});
+
+        if (std::abs(fc) < tol || std::abs(b - a) < tol) {
+            return {c, fc, iter, SolveStatus::Converged, evaluations, b - a, 0};
+        }
+
+        if (fa * fc < 0) {
+            b = c;
+            fb = fc;
+        } else {
+            a = c;
+            fa = fc;
+        }
+    }
+    return {c, fc, maxIter, SolveStatus::MaxIterations, evaluations, b - a, 0};
+}
+
+// Modified regula falsi. Plain false position keeps one endpoint fixed on
+// convex stretches and then converges only linearly; these variants scale
+// down the stored f value of an endpoint that survives twice in a row, which
+// pulls the next interpolation point across the root. Illinois halves it;
+// Anderson-Bjorck uses m = 1 - f(c)/f(replaced endpoint) (0.5 when that is
+// not positive). Both keep the root bracketed and use the contract of
+// falsePositionMethod: 2 + iterations evaluations, converged when |f(c)| <
+// tol or |b - a| < tol. Trace: a, b, c, f(c).
+template <bool andersonBjorck, class F, class Observer>
+RootResult modifiedFalsePosition(F&& f, double a, double b, double tol, int maxIter, Observer&& observer) {
+    int evaluations = 0;
+    auto eval = [&](double x) {
+        evaluations++;
+        return f(x);
+    };
+
+    double fa = eval(a);
+    double fb = eval(b);
+    if (fa * fb >= 0) {
+        return {a, fa, 0, SolveStatus::InvalidBracket, evaluations, b - a, 0};
+    }
+
+    double c = a, fc = fa;
+    int kept = 0;  // -1 if a survived the last step, +1 if b did
+    for (int iter = 1; iter <= maxIter; iter++) {
+        c = (a * fb - b * fa) / (fb - fa);
+        fc = eval(c);
+        observer(IterationRecord{iter, {a, b, c, fc}});
+
+        if (std::abs(fc) < tol || std::abs(b - a) < tol) {
+            return {c, fc, iter, SolveStatus::Converged, evaluations, b - a, 0};
+        }
+
+        if (fa * fc < 0) {
+            if (kept == -1) {
+                double m = andersonBjorck ? 1 - fc / fb : 0.5;
+                fa *= m > 0 ? m : 0.5;
+            }
+            b = c;
+            fb = fc;
+            kept = -1;
+        } else {
+            if (kept == 1) {
+                double m = andersonBjorck ? 1 - fc / fa : 0.5;
+                fb *= m > 0 ? m : 0.5;
+            }
+            a = c;
+            fa = fc;
+            kept = 1;
+        }
+    }
+    return {c, fc, maxIter, SolveStatus::MaxIterations, evaluations, b - a, 0};
+}
+
+template <class F, class Observer = NoTrace>
+RootResult illinoisMethod(F&& f, double a, double b, double tol, int maxIter, Observer&& observer = Observer()) {
+    return modifiedFalsePosition<false>(f, a, b, tol, maxIter, observer);
+}
+
+template <class F, class Observer = NoTrace>
+RootResult andersonBjorckMethod(F&& f, double a, double b, double tol, int maxIter, Observer&& observer = Observer()) {
+    return modifiedFalsePosition<true>(f, a, b, tol, maxIter, observer);
+}
+
+// Brent's method: each step tries inverse quadratic interpolation through
+// the last three points (or the secant through two) and falls back to
+// bisection whenever the interpolated step would leave the bracket or fails
+// to shrink it fast enough, so it never does worse than bisection by more
+// than a constant factor while converging superlinearly on smooth f. b is
+// the best estimate and [b, c] always brackets the root. Converged when the
+// half-width of the bracket is at most tol/2 plus a few ulps of b, or f(b) =
+// 0. 2 + iterations evaluations. Trace: previous b, c, new b, f(new b).
+template <class F, class Observer = NoTrace>
+RootResult brentMethod(F&& f, double a, double b, double tol, int maxIter, Observer&& observer = Observer()) {
+    int evaluations = 0;
+    auto eval = [&](double x) {
+        evaluations++;
+        return f(x);
+    };
+
+    double fa = eval(a);
+    double fb = eval(b);
+    if (fa * fb >= 0) {
+        return {a, fa, 0, SolveStatus::InvalidBracket, evaluations, b - a, 0};
+    }
+
+    double c = a, fc = fa;
+    double d = b - a, e = d;  // the last step and the one before
+    for (int iter = 0;; iter++) {
+        if ((fb > 0) == (fc > 0)) {
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+        if (std::abs(fc) < std::abs(fb)) {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+
+        double tol1 = 2 * std::numeric_limits<double>::epsilon() * std::abs(b) + tol / 2;
+        double m = (c - b) / 2;
+        if (std::abs(m) <= tol1 || fb == 0) {
+            return {b, fb, iter, SolveStatus::Converged, evaluations, std::abs(c - b), 0};
+        }
+        if (iter == maxIter) {
+            return {b, fb, iter, SolveStatus::MaxIterations, evaluations, std::abs(c - b), 0};
+        }
+
+        if (std::abs(e) < tol1 || std::abs(fa) <= std::abs(fb)) {
+            d = e = m;
+        } else {
+            double s = fb / fa, p, q;
+            if (a == c) {
+                p = 2 * m * s;
+                q = 1 - s;
+            } else {
+                double qa = fa / fc, r = fb / fc;
+                p = s * (2 * m * qa * (qa - r) - (b - a) * (r - 1));
+                q = (qa - 1) * (r - 1) * (s - 1);
+            }
+            if (p > 0) {
+                q = -q;
+            } else {
+                p = -p;
+            }
+            if (2 * p < std::min(3 * m * q - std::abs(tol1 * q), std::abs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = e = m;
+            }
+        }
+
+        a = b;
+        fa = fb;
+        b += std::abs(d) > tol1 ? d : (m > 0 ? tol1 : -tol1);
+        fb = eval(b);
+        observer(IterationRecord{iter + 1, {a, c, b, fb}});
+    }
+}
+
+// f(x(n-1)) is carried over, so 1 + iterations evaluations plus the residual.
+// Trace: x(n-1), x(n), f(x(n)), x(n+1).
+template <class F, class Observer = NoTrace>
+RootResult secantMethod(F&& f, double x0, double x1, double tol, int maxIter, Observer&& observer = Observer()) {
+    int evaluations = 0;
+    auto eval = [&](double x) {
+        evaluations++;
+        return f(x);
+    };
+
+    double xPrev = x0, x = x1;
+    double fxPrev = eval(xPrev);
+    for (int iter = 1; iter <= maxIter; iter++) {
+        double fx = eval(x);
+
+        if (std::abs(fx - fxPrev) < 1e-10) {
+            return {x, fx, iter, SolveStatus::ZeroDerivative, evaluations, std::abs(x - xPrev), 0};
+        }
+
+        double xNext = x - fx * (x - xPrev) / (fx - fxPrev);
+        observer(IterationRecord{iter, {xPrev, x, fx, xNext}});
+        if (std::abs(xNext - x) < tol || std::abs(fx) < tol) {
+            return {xNext, eval(xNext), iter, SolveStatus::Converged, evaluations, std::abs(xNext - x), 0};
+        }
+
+        xPrev = x;
+        fxPrev = fx;
+        x = xNext;
+    }
+    return {x, eval(x), maxIter, SolveStatus::MaxIterations, evaluations, std::abs(x - xPrev), 0};
+}
+
+// Newton's method for the polynomial with coefficients coeffs (highest
+// degree first); f and f' come from one pass over them, counted as one
+// evaluation. Trace: x(n), f(x(n)), f'(x(n)), x(n+1).
+template <class Observer = NoTrace>
+RootResult newtonRaphsonMethod(const std::vector<double>& coeffs, double x0, double tol, int maxIter, Observer&& observer = Observer()) {
+    double x = x0, step = 0;
+    for (int iter = 1; iter <= maxIter; iter++) {
+        Dual<double> y = evaluatePolynomialWithDerivative(coeffs, x);
+        double fx = y.value;
+        double fpx = y.derivative;
+
+        if (std::abs(fpx) < 1e-10) {
+            return {x, fx, iter, SolveStatus::ZeroDerivative, iter, step, 0};
+        }
+
+        double xNext = x - fx / fpx;
+        step = std::abs(xNext - x);
+        observer(IterationRecord{iter, {x, fx, fpx, xNext}});
+        if (step < tol || std::abs(fx) < tol) {
+            return {xNext, evaluatePolynomial(coeffs, xNext), iter, SolveStatus::Converged, iter + 1, step, 0};
+        }
+        x = xNext;
+    }
+    return {x, evaluatePolynomial(coeffs, x), maxIter, SolveStatus::MaxIterations, maxIter + 1, step, 0};
+}
+
+// Newton's method for any f written generically over its argument type (see
+// dual.h): f is evaluated on dual numbers, so each iteration gets f and f'
+// from a single call, with no derivative to supply and no finite-difference
+// step. Trace: x(n), f(x(n)), f'(x(n)), x(n+1).
+template <class F, class Observer = NoTrace, class = decltype(std::declval<F&>()(Dual<double>()))>
+RootResult newtonRaphsonMethod(F&& f, double x0, double tol, int maxIter, Observer&& observer = Observer()) {
+    double x = x0, step = 0;
+    for (int iter = 1; iter <= maxIter; iter++) {
+        Dual<double> y = f(variable(x));
+        double fx = y.value;
+        double fpx = y.derivative;
+
+        if (std::abs(fpx) < 1e-10) {
+            return {x, fx, iter, SolveStatus::ZeroDerivative, iter, step, 0};
+        }
+
+        double xNext = x - fx / fpx;
+        step = std::abs(xNext - x);
+        observer(IterationRecord{iter, {x, fx, fpx, xNext}});
+        if (step < tol || std::abs(fx) < tol) {
+            return {xNext, Dual<double>(f(Dual<double>(xNext))).value, iter, SolveStatus::Converged, iter + 1, step, 0};
+        }
+        x = xNext;
+    }
+    return {x, Dual<double>(f(Dual<double>(x))).value, maxIter, SolveStatus::MaxIterations, maxIter + 1, step, 0};
+}
+
+// Fixed-point iteration x(n+1) = g(x(n)) for any callable g, and two
+// accelerated forms. All three stop when the iterates settle to within tol
+// and report as residual g(x) - x at the last point where g was evaluated.
+
+// One evaluation per iteration; converges linearly when |g'| < 1 near the
+// fixed point and diverges when |g'| > 1. Trace: x(n), g(x(n)).
+template <class G, class Observer = NoTrace>
+RootResult fixedPointIteration(G&& g, double x0, double tol, int maxIter, Observer&& observer = Observer()) {
+    double x = x0, step = 0, residual = 0;
+    for (int iter = 1; iter <= maxIter; iter++) {
+        double gx = g(x);
+        residual = gx - x;
+        step = std::abs(residual);
+        observer(IterationRecord{iter, {x, gx}});
+        x = gx;
+        if (step < tol) {
+            return {x, residual, iter, SolveStatus::Converged, iter, step, 0};
+        }
+    }
+    return {x, residual, maxIter, SolveStatus::MaxIterations, maxIter, step, 0};
+}
+
+// Iterates g(x) = x - f(x) for the polynomial f with fixedPointIteration,
+// reporting f at the result as the residual. Trace: x(n), g(x(n)), f(x(n)).
+template <class Observer = NoTrace>
+RootResult fixedPointMethod(const std::vector<double>& coeffs, double x0, double tol, int maxIter, Observer&& observer = Observer()) {
+    auto g = [&](double x) { return x - evaluatePolynomial(coeffs, x); };
+    auto withF = [&](const IterationRecord& r) {
+        observer(IterationRecord{r.iteration, {r.values[0], r.values[1], r.values[0] - r.values[1]}});
+    };
+    RootResult result = fixedPointIteration(FunctionRef(g), x0, tol, maxIter, withF);
+    result.residual = evaluatePolynomial(coeffs, result.root);
+    result.evaluations++;
+    return result;
+}
+
+// Aitken's delta-squared process on the plain iteration: g is iterated as
+// usual, one evaluation per iteration, and every three consecutive iterates
+// x0, x1, x2 give the estimate x2 - (x2 - x1)^2 / (x2 - 2 x1 + x0), which
+// cancels the leading error term of a linearly converging sequence. Stops
+// when successive estimates differ by less than tol while the iterates are
+// still contracting; use Steffensen when |g'| > 1. Trace: x(n), x(n+1),
+// estimate.
+template <class G, class Observer = NoTrace>
+RootResult aitkenFixedPoint(G&& g, double x0, double tol, int maxIter, Observer&& observer = Observer()) {
+    double x1 = g(x0);
+    double estimate = x1, step = 0;
+    for (int iter = 1; iter <= maxIter; iter++) {
+        double x2 = g(x1);
+        double denominator = x2 - 2 * x1 + x0;
+        double next = denominator != 0 ? x2 - (x2 - x1) * (x2 - x1) / denominator : x2;
+        observer(IterationRecord{iter, {x1, x2, next}});
+
+        // The estimate only means something while the iteration contracts;
+        // from a diverging sequence it can settle on garbage.
+        step = std::abs(next - estimate);
+        if (step < tol && std::abs(x2 - x1) < std::abs(x1 - x0)) {
+            return {next, x2 - x1, iter, SolveStatus::Converged, iter + 1, step, 0};
+        }
+        estimate = next;
+        x0 = x1;
+        x1 = x2;
+    }
+    return {estimate, x1 - x0, maxIter, SolveStatus::MaxIterations, maxIter + 1, step, 0};
+}
+
+// Steffensen's method: each iteration takes x, g(x), g(g(x)) and restarts
+// from their Aitken estimate. Up to two evaluations per iteration (g(g(x))
+// is skipped once g(x) is within tol of x), but convergence is quadratic,
+// and it also converges where the plain iteration diverges (|g'| > 1), so
+// long as it starts close enough. Trace: x(n), g(x(n)), g(g(x(n))), x(n+1).
+template <class G, class Observer = NoTrace>
+RootResult steffensenFixedPoint(G&& g, double x0, double tol, int maxIter, Observer&& observer = Observer()) {
+    int evaluations = 0;
+    auto eval = [&](double x) {
+        evaluations++;
+        return g(x);
+    };
+
+    double x = x0, step = 0, residual = 0;
+    for (int iter = 1; iter <= maxIter; iter++) {
+        double gx = eval(x);
+        residual = gx - x;
+        if (std::abs(residual) < tol) {
+            return {gx, residual, iter, SolveStatus::Converged, evaluations, std::abs(residual), 0};
+        }
+
+        double ggx = eval(gx);
+        double denominator = ggx - 2 * gx + x;
+        if (denominator == 0) {
+            return {ggx, ggx - gx, iter, SolveStatus::ZeroDerivative, evaluations, step, 0};
+        }
+        double xNext = x - residual * residual / denominator;
+        observer(IterationRecord{iter, {x, gx, ggx, xNext}});
+
+        step = std::abs(xNext - x);
+        x = xNext;
+        if (step < tol) {
+            return {x, residual, iter, SolveStatus::Converged, evaluations, step, 0};
+        }
+    }
+    return {x, residual, maxIter, SolveStatus::MaxIterations, evaluations, step, 0};
+}
+
+// Minimizes a unimodal f on [a, b]. The interior points divide the
+// interval in the golden ratio, so after the interval shrinks the surviving
+// point is already where one of the next pair has to be and only the other
+// one is evaluated: 2 + iterations evaluations. The result is the better of
+// the last two points. Trace: a, b, x1, x2, f(x1), f(x2).
+template <class F, class Observer = NoTrace>
+MinimumResult goldenSectionSearch(F&& f, double a, double b, double tol, int maxIter, Observer&& observer = Observer()) {
+    const double invPhi = (std::sqrt(5.0) - 1) / 2;
+
+    double x1 = b - invPhi * (b - a);
+    double x2 = a + invPhi * (b - a);
+    double f1 = f(x1);
+    double f2 = f(x2);
+    int iter = 0;
+    while (iter < maxIter && (b - a) > tol) {
+        iter++;
+        observer(IterationRecord{iter, {a, b, x1, x2, f1, f2}});
+
+        if (f1 < f2) {
+            b = x2;
+            x2 = x1;
+            f2 = f1;
+            x1 = b - invPhi * (b - a);
+            f1 = f(x1);
+        } else {
+            a = x1;
+            x1 = x2;
+            f1 = f2;
+            x2 = a + invPhi * (b - a);
+            f2 = f(x2);
+        }
+    }
+
+    SolveStatus status = (b - a) > tol ? SolveStatus::MaxIterations : SolveStatus::Converged;
+    if (f1 < f2) return {x1, f1, iter, status, 2 + iter, b - a, 0};
+    return {x2, f2, iter, status, 2 + iter, b - a, 0};
+}
+
+// Brent's minimizer: fits a parabola through the three best points so far
+// and steps to its vertex when that lies inside [a, b] and moves less than
+// half the step before last; otherwise takes a golden-section step into the
+// larger part of the interval. Superlinear on smooth f, and never much worse
+// than golden section. Converged when [a, b] is within about tol of the best
+// point x, though not below sqrt(eps) |x|, since f is flat to rounding that
+// close to a minimum. 1 + iterations evaluations. Trace: a, b, x, u, f(x),
+// f(u), u being the new point.
+template <class F, class Observer = NoTrace>
+MinimumResult brentMinimize(F&& f, double a, double b, double tol, int maxIter, Observer&& observer = Observer()) {
+    const double shrink = (3 - std::sqrt(5.0)) / 2;
+    const double sqrtEps = std::sqrt(std::numeric_limits<double>::epsilon());
+
+    // x: best point, w: second best, v: the previous w.
+    double x = a + shrink * (b - a), w = x, v = x;
+    double fx = f(x), fw = fx, fv = fx;
+    double d = 0, e = 0;  // last step and the one before
+    for (int iter = 1; iter <= maxIter; iter++) {
+        double xm = (a + b) / 2;
+        double tol1 = sqrtEps * std::abs(x) + tol / 4, tol2 = 2 * tol1;
+        if (std::abs(x - xm) <= tol2 - (b - a) / 2) {
+            return {x, fx, iter - 1, SolveStatus::Converged, iter, b - a, 0};
+        }
+
+        bool parabolic = false;
+        if (std::abs(e) > tol1) {
+            double r = (x - w) * (fx - fv);
+            double q = (x - v) * (fx - fw);
+            double p = (x - v) * q - (x - w) * r;
+            q = 2 * (q - r);
+            if (q > 0) p = -p;
+            q = std::abs(q);
+            double before = e;
+            e = d;
+            if (std::abs(p) < std::abs(q * before / 2) && p > q * (a - x) && p < q * (b - x)) {
+                d = p / q;
+                double u = x + d;
+                if (u - a < tol2 || b - u < tol2) d = std::copysign(tol1, xm - x);
+                parabolic = true;
+            }
+        }
+        if (!parabolic) {
+            e = (x >= xm ? a : b) - x;
+            d = shrink * e;
+        }
+
+        double u = std::abs(d) >= tol1 ? x + d : x + std::copysign(tol1, d);
+        double fu = f(u);
+        observer(IterationRecord{iter, {a, b, x, u, fx, fu}});
+
+        if (fu <= fx) {
+            if (u >= x) {
+                a = x;
+            } else {
+                b = x;
+            }
+            v = w;
+            fv = fw;
+            w = x;
+            fw = fx;
+            x = u;
+            fx = fu;
+        } else {
+            if (u < x) {
+                a = u;
+            } else {
+                b = u;
+            }
+            if (fu <= fw || w == x) {
+                v = w;
+                fv = fw;
+                w = u;
+                fw = fu;
+            } else if (fu <= fv || v == x || v == w) {
+                v = u;
+                fv = fu;
+            }
+        }
+    }
+    return {x, fx, maxIter, SolveStatus::MaxIterations, 1 + maxIter, b - a, 0};
+}
+
+#endif
@@ -0,0 +1,288 @@
+#ifndef ROW_KERNELS_H
+#define ROW_KERNELS_H
+
+// Row update kernels shared by every elimination loop:
+//   rowAxpy:         y -= a * x
+//   rowAxpyTargets4: y[t] -= a[t] * x for four target rows, x loaded once
+//   rowAxpySources4: y -= a[0] * x[0] + ... + a[3] * x[3], y loaded once
+// The widest instruction set the CPU supports is picked once at runtime.
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ROW_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+enum class SimdLevel { Scalar, SSE2, AVX2, AVX512 };
+
+struct RowKernels {
+    void (*axpy)(double* y, const double* x, double a, int n);
+    void (*axpyTargets4)(double* const* y, const double* x, const double* a, int n);
+    void (*axpySources4)(double* y, const double* const* x, const double* a, int n);
+};
+
+inline void rowAxpyScalar(double* y, const double* x, double a, int n) {
+    for (int j = 0; j < n; j++) {
+        y[j] -= a * x[j];
+    }
+}
+
+inline void rowAxpyTargets4Scalar(double* const* y, const double* x, const double* a, int n) {
+    double* y0 = y[0];
+    double* y1 = y[1];
+    double* y2 = y[2];
+    double* y3 = y[3];
+    for (int j = 0; j < n; j++) {
+        double xj = x[j];
+        y0[j] -= a[0] * xj;
+        y1[j] -= a[1] * xj;
+        y2[j] -= a[2] * xj;
+        y3[j] -= a[3] * xj;
+    }
+}
+
+inline void rowAxpySources4Scalar(double* y, const double* const* x, const double* a, int n) {
+    const double* x0 = x[0];
+    const double* x1 = x[1];
+    const double* x2 = x[2];
+    const double* x3 = x[3];
+    for (int j = 0; j < n; j++) {
+        y[j] = y[j] - a[0] * x0[j] - a[1] * x1[j] - a[2] * x2[j] - a[3] * x3[j];
+    }
+}
+
+#ifdef ROW_KERNELS_X86
+
+__attribute__((target("sse2")))
+inline void rowAxpySSE2(double* y, const double* x, double a, int n) {
+    __m128d va = _mm_set1_pd(a);
+    int j = 0;
+    for (; j + 2 <= n; j += 2) {
+        __m128d vy = _mm_loadu_pd(y + j);
+        vy = _mm_sub_pd(vy, _mm_mul_pd(va, _mm_loadu_pd(x + j)));
+        _mm_storeu_pd(y + j, vy);
+    }
+    rowAxpyScalar(y + j, x + j, a, n - j);
+}
+
+__attribute__((target("sse2")))
+inline void rowAxpyTargets4SSE2(double* const* y, const double* x, const double* a, int n) {
+    __m128d a0 = _mm_set1_pd(a[0]), a1 = _mm_set1_pd(a[1]);
+    __m128d a2 = _mm_set1_pd(a[2]), a3 = _mm_set1_pd(a[3]);
+    double* y0 = y[0];
+    double* y1 = y[1];
+    double* y2 = y[2];
+    double* y3 = y[3];
+    int j = 0;
+    for (; j + 2 <= n; j += 2) {
+        __m128d vx = _mm_loadu_pd(x + j);
+        _mm_storeu_pd(y0 + j, _mm_sub_pd(_mm_loadu_pd(y0 + j), _mm_mul_pd(a0, vx)));
+        _mm_storeu_pd(y1 + j, _mm_sub_pd(_mm_loadu_pd(y1 + j), _mm_mul_pd(a1, vx)));
+        _mm_storeu_pd(y2 + j, _mm_sub_pd(_mm_loadu_pd(y2 + j), _mm_mul_pd(a2, vx)));
+        _mm_storeu_pd(y3 + j, _mm_sub_pd(_mm_loadu_pd(y3 + j), _mm_mul_pd(a3, vx)));
+    }
+    for (; j < n; j++) {
+        y0[j] -= a[0] * x[j];
+        y1[j] -= a[1] * x[j];
+        y2[j] -= a[2] * x[j];
+        y3[j] -= a[3] * x[j];
+    }
+}
+
+__attribute__((target("sse2")))
+inline void rowAxpySources4SSE2(double* y, const double* const* x, const double* a, int n) {
+    __m128d a0 = _mm_set1_pd(a[0]), a1 = _mm_set1_pd(a[1]);
+    __m128d a2 = _mm_set1_pd(a[2]), a3 = _mm_set1_pd(a[3]);
+    const double* x0 = x[0];
+    const double* x1 = x[1];
+    const double* x2 = x[2];
+    const double* x3 = x[3];
+    int j = 0;
+    for (; j + 2 <= n; j += 2) {
+        __m128d vy = _mm_loadu_pd(y + j);
+        vy = _mm_sub_pd(vy, _mm_mul_pd(a0, _mm_loadu_pd(x0 + j)));
+        vy = _mm_sub_pd(vy, _mm_mul_pd(a1, _mm_loadu_pd(x1 + j)));
+        vy = _mm_sub_pd(vy, _mm_mul_pd(a2, _mm_loadu_pd(x2 + j)));
+        vy = _mm_sub_pd(vy, _mm_mul_pd(a3, _mm_loadu_pd(x3 + j)));
+        _mm_storeu_pd(y + j, vy);
+    }
+    for (; j < n; j++) {
+        y[j] = y[j] - a[0] * x0[j] - a[1] * x1[j] - a[2] * x2[j] - a[3] * x3[j];
+    }
+}
+
+__attribute__((target("avx2,fma")))
+inline void rowAxpyAVX2(double* y, const double* x, double a, int n) {
+    __m256d va = _mm256_set1_pd(a);
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d vy = _mm256_fnmadd_pd(va, _mm256_loadu_pd(x + j), _mm256_loadu_pd(y + j));
+        _mm256_storeu_pd(y + j, vy);
+    }
+    rowAxpyScalar(y + j, x + j, a, n - j);
+}
+
+__attribute__((target("avx2,fma")))
+inline void rowAxpyTargets4AVX2(double* const* y, const double* x, const double* a, int n) {
+    __m256d a0 = _mm256_set1_pd(a[0]), a1 = _mm256_set1_pd(a[1]);
+    __m256d a2 = _mm256_set1_pd(a[2]), a3 = _mm256_set1_pd(a[3]);
+    double* y0 = y[0];
+    double* y1 = y[1];
+    double* y2 = y[2];
+    double* y3 = y[3];
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d vx = _mm256_loadu_pd(x + j);
+        _mm256_storeu_pd(y0 + j, _mm256_fnmadd_pd(a0, vx, _mm256_loadu_pd(y0 + j)));
+        _mm256_storeu_pd(y1 + j, _mm256_fnmadd_pd(a1, vx, _mm256_loadu_pd(y1 + j)));
+        _mm256_storeu_pd(y2 + j, _mm256_fnmadd_pd(a2, vx, _mm256_loadu_pd(y2 + j)));
+        _mm256_storeu_pd(y3 + j, _mm256_fnmadd_pd(a3, vx, _mm256_loadu_pd(y3 + j)));
+    }
+    for (; j < n; j++) {
+        y0[j] -= a[0] * x[j];
+        y1[j] -= a[1] * x[j];
+        y2[j] -= a[2] * x[j];
+        y3[j] -= a[3] * x[j];
+    }
+}
+
+__attribute__((target("avx2,fma")))
+inline void rowAxpySources4AVX2(double* y, const double* const* x, const double* a, int n) {
+    __m256d a0 = _mm256_set1_pd(a[0]), a1 = _mm256_set1_pd(a[1]);
+    __m256d a2 = _mm256_set1_pd(a[2]), a3 = _mm256_set1_pd(a[3]);
+    const double* x0 = x[0];
+    const double* x1 = x[1];
+    const double* x2 = x[2];
+    const double* x3 = x[3];
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d vy = _mm256_loadu_pd(y + j);
+        vy = _mm256_fnmadd_pd(a0, _mm256_loadu_pd(x0 + j), vy);
+        vy = _mm256_fnmadd_pd(a1, _mm256_loadu_pd(x1 + j), vy);
+        vy = _mm256_fnmadd_pd(a2, _mm256_loadu_pd(x2 + j), vy);
+        vy = _mm256_fnmadd_pd(a3, _mm256_loadu_pd(x3 + j), vy);
+        _mm256_storeu_pd(y + j, vy);
+    }
+    for (; j < n; j++) {
+        y[j] = y[j] - a[0] * x0[j] - a[1] * x1[j] - a[2] * x2[j] - a[3] * x3[j];
+    }
+}
+
+__attribute__((target("avx512f")))
+inline void rowAxpyAVX512(double* y, const double* x, double a, int n) {
+    __m512d va = _mm512_set1_pd(a);
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m512d vy = _mm512_fnmadd_pd(va, _mm512_loadu_pd(x + j), _mm512_loadu_pd(y + j));
+        _mm512_storeu_pd(y + j, vy);
+    }
+    rowAxpyScalar(y + j, x + j, a, n - j);
+}
+
+__attribute__((target("avx512f")))
+inline void rowAxpyTargets4AVX512(double* const* y, const double* x, const double* a, int n) {
+    __m512d a0 = _mm512_set1_pd(a[0]), a1 = _mm512_set1_pd(a[1]);
+    __m512d a2 = _mm512_set1_pd(a[2]), a3 = _mm512_set1_pd(a[3]);
+    double* y0 = y[0];
+    double* y1 = y[1];
+    double* y2 = y[2];
+    double* y3 = y[3];
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m512d vx = _mm512_loadu_pd(x + j);
+        _mm512_storeu_pd(y0 + j, _mm512_fnmadd_pd(a0, vx, _mm512_loadu_pd(y0 + j)));
+        _mm512_storeu_pd(y1 + j, _mm512_fnmadd_pd(a1, vx, _mm512_loadu_pd(y1 + j)));
+        _mm512_storeu_pd(y2 + j, _mm512_fnmadd_pd(a2, vx, _mm512_loadu_pd(y2 + j)));
+        _mm512_storeu_pd(y3 + j, _mm512_fnmadd_pd(a3, vx, _mm512_loadu_pd(y3 + j)));
+    }
+    for (; j < n; j++) {
+        y0[j] -= a[0] * x[j];
+        y1[j] -= a[1] * x[j];
+        y2[j] -= a[2] * x[j];
+        y3[j] -= a[3] * x[j];
+    }
+}
+
+__attribute__((target("avx512f")))
+inline void rowAxpySources4AVX512(double* y, const double* const* x, const double* a, int n) {
+    __m512d a0 = _mm512_set1_pd(a[0]), a1 = _mm512_set1_pd(a[1]);
+    __m512d a2 = _mm512_set1_pd(a[2]), a3 = _mm512_set1_pd(a[3]);
+    const double* x0 = x[0];
+    const double* x1 = x[1];
+    const double* x2 = x[2];
+    const double* x3 = x[3];
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m512d vy = _mm512_loadu_pd(y + j);
+        vy = _mm512_fnmadd_pd(a0, _mm512_loadu_pd(x0 + j), vy);
+        vy = _mm512_fnmadd_pd(a1, _mm512_loadu_pd(x1 + j), vy);
+        vy = _mm512_fnmadd_pd(a2, _mm512_loadu_pd(x2 + j), vy);
+        vy = _mm512_fnmadd_pd(a3, _mm512_loadu_pd(x3 + j), vy);
+        _mm512_storeu_pd(y + j, vy);
+    }
+    for (; j < n; j++) {
+        y[j] = y[j] - a[0] * x0[j] - a[1] * x1[j] - a[2] * x2[j] - a[3] * x3[j];
+    }
+}
+
+#endif
+
+inline SimdLevel detectSimdLevel() {
+#ifdef ROW_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+inline RowKernels rowKernelsFor(SimdLevel level) {
+#ifdef ROW_KERNELS_X86
+    switch (level) {
+    case SimdLevel::AVX512:
+        return {rowAxpyAVX512, rowAxpyTargets4AVX512, rowAxpySources4AVX512};
+    case SimdLevel::AVX2:
+        return {rowAxpyAVX2, rowAxpyTargets4AVX2, rowAxpySources4AVX2};
+    case SimdLevel::SSE2:
+        return {rowAxpySSE2, rowAxpyTargets4SSE2, rowAxpySources4SSE2};
+    default:
+        break;
+    }
+#else
+    (void)level;
+#endif
+    return {rowAxpyScalar, rowAxpyTargets4Scalar, rowAxpySources4Scalar};
+}
+
+inline RowKernels& rowKernels() {
+    static RowKernels kernels = rowKernelsFor(detectSimdLevel());
+    return kernels;
+}
+
+// Forces a particular kernel set, e.g. the scalar one when comparing results.
+inline void setSimdLevel(SimdLevel level) {
+    rowKernels() = rowKernelsFor(level);
+}
+
+inline void rowAxpy(double* y, const double* x, double a, int n) {
+    rowKernels().axpy(y, x, a, n);
+}
+
+inline void rowAxpySources4(double* y, const double* const* x, const double* a, int n) {
+    rowKernels().axpySources4(y, x, a, n);
+}
+
+// rows[t] -= factors[t] * x for every t < count, four target rows per pass so
+// each element of x is loaded once per group instead of once per row.
+inline void rowAxpyMany(double* const* rows, const double* factors, int count, const double* x, int n) {
+    const RowKernels& kernels = rowKernels();
+    int t = 0;
+    for (; t + 4 <= count; t += 4) {
+        kernels.axpyTargets4(rows + t, x, factors + t, n);
+    }
+    for (; t < count; t++) {
+        kernels.axpy(rows[t], x, factors[t], n);
+    }
+}
+
+#endif
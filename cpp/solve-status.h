@@ -0,0 +1,25 @@
+#ifndef SOLVE_STATUS_H
+#define SOLVE_STATUS_H
+
+// How a solver run ended. Every result struct in the numerical library
+// carries one; only Converged means the returned value can be trusted.
+enum class SolveStatus {
+    Converged,
+    MaxIterations,   // iteration limit reached before the tolerance was met
+    InvalidBracket,  // f(a) and f(b) do not have opposite signs
+    ZeroDerivative,  // the derivative (or secant slope) vanished
+    Singular,        // the linear system has no unique solution
+};
+
+inline const char* statusMessage(SolveStatus status) {
+    switch (status) {
+    case SolveStatus::Converged: return "converged";
+    case SolveStatus::MaxIterations: return "maximum iterations reached before convergence";
+    case SolveStatus::InvalidBracket: return "f(a) and f(b) must have opposite signs";
+    case SolveStatus::ZeroDerivative: return "derivative is too close to zero, method fails";
+    case SolveStatus::Singular: return "matrix is singular, no unique solution exists";
+    }
+    return "unknown status";
+}
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Roughly how many doubles a chunk should update before it is worth handing
+// to another thread.
+const int PARALLEL_MIN_WORK = 1 << 15;
+
+// Thread count for a pool that is only worth starting when a loop will
+// update at least PARALLEL_MIN_WORK doubles; below that the pool gets no
+// workers, so small solves never spawn threads.
+inline int poolThreads(int threads, long long work) {
+    return work >= PARALLEL_MIN_WORK ? threads : 1;
+}
+
+// Fixed set of worker threads for fork-join loops. parallelFor hands each
+// worker (and the calling thread) one contiguous chunk and waits for all of
+// them, so it can be called once per pivot without spawning threads.
+class ThreadPool {
+public:
+    // threads <= 0 uses every hardware thread.
+    explicit ThreadPool(int threads = 0) {
+        if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        for (int w = 1; w < threads; w++) {
+            workers.emplace_back([this, w] { workerLoop(w); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            generation++;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers) {
+            t.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return (int)workers.size() + 1; }
+
+    // Calls body(lo, hi) over disjoint chunks covering [begin, end). Chunks
+    // are at least minChunk long, so small loops stay on the calling thread.
+    template <class Body>
+    void parallelFor(int begin, int end, int minChunk, Body body) {
+        int count = end - begin;
+        if (count <= 0) return;
+        int chunks = std::min(size(), std::max(1, count / std::max(1, minChunk)));
+        if (chunks == 1) {
+            body(begin, end);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &invoke<Body>;
+            jobContext = &body;
+            jobBegin = begin;
+            jobEnd = end;
+            jobChunks = chunks;
+            pending = chunks - 1;
+            generation++;
+        }
+        wake.notify_all();
+
+        body(begin, begin + count / chunks);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        job = nullptr;
+    }
+
+private:
+    template <class Body>
+    static void invoke(void* body, int lo, int hi) {
+        (*static_cast<Body*>(body))(lo, hi);
+    }
+
+    void workerLoop(int w) {
+        unsigned long seen = 0;
+        for (;;) {
+            void (*body)(void*, int, int);
+            void* context;
+            int lo, hi;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return generation != seen; });
+                seen = generation;
+                if (stopping) return;
+                if (w >= jobChunks) continue;
+                int count = jobEnd - jobBegin;
+                lo = jobBegin + (int)((long long)count * w / jobChunks);
+                hi = jobBegin + (int)((long long)count * (w + 1) / jobChunks);
+                body = job;
+                context = jobContext;
+            }
+
+            body(context, lo, hi);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) done.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake, done;
+    void (*job)(void*, int, int) = nullptr;
+    void* jobContext = nullptr;
+    int jobBegin = 0, jobEnd = 0, jobChunks = 0, pending = 0;
+    unsigned long generation = 0;
+    bool stopping = false;
+};
+
+#endif